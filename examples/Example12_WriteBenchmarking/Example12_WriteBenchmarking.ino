@@ -38,6 +38,9 @@
 #include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
 OpenLog myLog; //Create instance
 
+//The 110 character line, stored in flash and split into 32 byte transactions at compile time
+QOL_CONSTANT_LINE(testLine, ":abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ-#\r\n");
+
 int ledPin = 13; //Status LED connected to digital pin 13
 
 void setup()
@@ -148,6 +151,50 @@ void setup()
   Serial.println(throughput, 3);
   Serial.println();
 
+  //-=-=-=-= Finish direct test
+
+  Serial.println("Test using constant lines");
+  myLog.println("Run OpenLog Test");
+  long startTimeConstant = millis();
+
+  //Each test is 100 lines. 10 tests is 1000 lines (11,000 characters)
+  for (int numofTests = 0 ; numofTests < testAmt ; numofTests++)
+  {
+    //This loop will print 100 lines of 110 characters each
+    for (byte k = 33; k < 43 ; k++)
+    {
+      //Print one line of 110 characters with marker in the front (markers go from '!' to '*')
+      myLog.write(k);
+      myLog.write(testLine);
+
+      //Then print 9 lines of 110 characters with new line at the end of the line
+      for (byte i = 1 ; i < 10 ; i++)
+      {
+        myLog.write('0' + i);
+        myLog.write(testLine);
+      }
+
+      if (digitalRead(ledPin) == 0) //Turn the status LED on/off as we go
+        digitalWrite(ledPin, HIGH);
+      else
+        digitalWrite(ledPin, LOW);
+    }
+  }
+
+  long endTimeConstant = millis();
+
+  myLog.println("Done!\n");
+
+  Serial.print("Characters pushed: ");
+  Serial.println(totalCharacters);
+  Serial.print("Time taken (ms): ");
+  Serial.println(endTimeConstant - startTimeConstant);
+  Serial.print("Throughput kb/sec: ");
+  throughput = (endTimeConstant - startTimeConstant) / 1000.0;
+  throughput = totalCharacters / throughput;
+  Serial.println(throughput, 3);
+  Serial.println();
+
 }
 
 void loop()
@@ -0,0 +1,100 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  NOTE: This is a benchmarking sketch for Qwiic OpenLog and is not often needed by general users.
+
+  This shows how to batch writes into SD sector sized bursts and compares the stalls against unbatched writes.
+
+  Qwiic OpenLog commits data to the SD card 512 bytes (one sector) at a time. While it does this it holds
+  the clock line (clock stretching) and the master has to wait. When writes are sent as they happen, these
+  waits land on random writes in the middle of our logging. With a write buffer the library collects a full
+  sector and sends it as 16 back-to-back 32 byte chunks, lined up with the sector boundaries, so the
+  commit happens once per burst.
+
+  For each test we record how long every write takes, the worst write, and how many writes took longer than
+  the stall threshold.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+OpenLog myLog; //Create instance
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+uint8_t sectorBuffer[QOL_SECTOR_SIZE]; //Holds one SD sector worth of data
+
+#define STALL_THRESHOLD_US 2000 //A write that takes longer than this is counted as a stall
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Serial.begin(9600); //9600bps is used for debug statements
+
+  Wire.begin();
+  Wire.setClock(400000); //Set I2C bus speed to fast 400kHz
+  myLog.begin();
+
+  Serial.println();
+  Serial.println("Run OpenLog Sector Batching Test");
+  Serial.println(F("Press a key to begin"));
+  while(Serial.available()) Serial.read(); //Clear buffer
+  while(Serial.available() == 0) delay(10); //Wait for user to press a key
+
+  Serial.println("Test without batching");
+  myLog.append("unbatch.txt");
+  runTest();
+
+  Serial.println("Test with sector batching");
+  myLog.append("batch.txt");
+  myLog.setWriteBuffer(sectorBuffer, sizeof(sectorBuffer));
+  runTest();
+  myLog.flush(); //Send the last partial sector
+  myLog.setWriteBuffer(NULL, 0);
+
+  Serial.println("Done!");
+}
+
+void loop()
+{
+  //Blink the Status LED because we're done!
+  digitalWrite(ledPin, HIGH);
+  delay(100);
+  digitalWrite(ledPin, LOW);
+  delay(1000);
+}
+
+//Print 1,000 lines of 110 characters and time each write
+void runTest()
+{
+  unsigned long worstWrite = 0;
+  unsigned long stalls = 0;
+  unsigned long startTime = millis();
+
+  for (int line = 0 ; line < 1000 ; line++)
+  {
+    unsigned long writeStart = micros();
+    myLog.print(line % 10, DEC);
+    myLog.print(":abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ-#\r\n");
+    unsigned long writeTime = micros() - writeStart;
+
+    if (writeTime > worstWrite) worstWrite = writeTime;
+    if (writeTime > STALL_THRESHOLD_US) stalls++;
+
+    if (line % 100 == 0) digitalWrite(ledPin, !digitalRead(ledPin)); //Turn the status LED on/off as we go
+  }
+
+  unsigned long endTime = millis();
+
+  Serial.print("Time taken (ms): ");
+  Serial.println(endTime - startTime);
+  Serial.print("Worst write (us): ");
+  Serial.println(worstWrite);
+  Serial.print("Writes over stall threshold: ");
+  Serial.println(stalls);
+  Serial.println();
+}
@@ -0,0 +1,83 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to control when data is actually on the SD card.
+
+  There are two places data can wait before it is recorded:
+  1) The library's write buffer (if you've given it one with setWriteBuffer). flush() sends this to OpenLog.
+  2) OpenLog's own buffer. OpenLog records to the SD card one sector at a time. sync() flushes and then
+  tells OpenLog to commit whatever it has to the card.
+
+  A sync is much more expensive than a flush so rather than syncing after every line we sync once a second.
+  If power is lost we lose at most one second of data. The stats show what each call costs.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+OpenLog myLog; //Create instance
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+uint8_t sectorBuffer[QOL_SECTOR_SIZE]; //Holds one SD sector worth of data
+
+unsigned long lastSync = 0;
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Sync Example");
+
+  myLog.setWriteBuffer(sectorBuffer, sizeof(sectorBuffer));
+
+  //Record 10 seconds of readings
+  unsigned long startTime = millis();
+  while (millis() - startTime < 10000)
+  {
+    myLog.print(millis());
+    myLog.print(",");
+    myLog.println(analogRead(A0));
+
+    if (millis() - lastSync > 1000)
+    {
+      lastSync = millis();
+      if (myLog.sync() == false)
+        Serial.println("Sync failed");
+    }
+  }
+
+  myLog.sync(); //Make sure the last readings are on the card
+
+  OpenLogStats stats = myLog.getStats();
+  Serial.print("Flushes: ");
+  Serial.print(stats.flushCount);
+  Serial.print(" Average flush (us): ");
+  if (stats.flushCount > 0) Serial.println(stats.flushMicros / stats.flushCount);
+  else Serial.println("-");
+
+  Serial.print("Syncs: ");
+  Serial.print(stats.syncCount);
+  Serial.print(" Average sync (us): ");
+  if (stats.syncCount > 0) Serial.println(stats.syncMicros / stats.syncCount);
+  else Serial.println("-");
+
+  Serial.println("Done!");
+}
+
+void loop()
+{
+  //Blink the Status LED because we're done!
+  digitalWrite(ledPin, HIGH);
+  delay(100);
+  digitalWrite(ledPin, LOW);
+  delay(1000);
+}
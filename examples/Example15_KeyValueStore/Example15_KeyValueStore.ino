@@ -0,0 +1,73 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to keep settings such as calibration values and counters on the SD card.
+
+  Each change is appended to CONFIG0.KV as a "key=value" line and synced to the card so a power loss
+  can't lose it. The library remembers where each value is so reading a value back is a single read.
+  Once the file is mostly old values the live values are copied to CONFIG1.KV and CONFIG0.KV is removed.
+
+  Between changes OpenLog goes back to recording to our normal log.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogKeyValue.h"
+OpenLog myLog; //Create instance
+OpenLogKeyValue settings;
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Key Value Example");
+
+  myLog.append("datalog.txt"); //This is where our readings go
+
+  if (settings.begin(myLog, "config0.kv", "config1.kv") == false)
+  {
+    Serial.println("Settings failed to load. Freezing.");
+    while (1);
+  }
+
+  //Count how many times we've been powered on
+  char value[QOL_KV_VALUE_LENGTH + 1];
+  long bootCount = 0;
+  if (settings.get("boots", value, sizeof(value)) > 0)
+    bootCount = atol(value);
+  bootCount++;
+  settings.put("boots", String(bootCount).c_str());
+
+  //Store a calibration value
+  settings.put("offset", "-12.5");
+
+  Serial.print("Boot count: ");
+  Serial.println(bootCount);
+
+  settings.get("offset", value, sizeof(value));
+  Serial.print("Offset: ");
+  Serial.println(value);
+
+  myLog.println("Settings loaded"); //Recorded to datalog.txt
+
+  Serial.println("Done!");
+}
+
+void loop()
+{
+  //Blink the Status LED because we're done!
+  digitalWrite(ledPin, HIGH);
+  delay(100);
+  digitalWrite(ledPin, LOW);
+  delay(1000);
+}
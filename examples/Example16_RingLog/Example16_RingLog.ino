@@ -0,0 +1,55 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to log forever without filling the SD card.
+
+  The log is split across 8 segment files (RING00.LOG to RING07.LOG) of up to 1MB each. When a segment
+  fills up the oldest segment is removed and logging continues there, so the card never holds more than 8MB
+  of log. Segment sizes are tracked by the library so logging never has to stop to list or size files.
+
+  After a reset the ring picks up where it left off.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogRing.h"
+OpenLog myLog; //Create instance
+OpenLogRing ringLog;
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Ring Log Example");
+
+  if (ringLog.begin(myLog, "RING", 8, 1000000) == false)
+  {
+    Serial.println("Ring log failed to start. Freezing.");
+    while (1);
+  }
+
+  Serial.print("Recording to ");
+  Serial.println(ringLog.getSegmentName(ringLog.getCurrentSegment()));
+}
+
+void loop()
+{
+  //Use ringLog just like myLog
+  ringLog.print(millis());
+  ringLog.print(",");
+  ringLog.println(analogRead(A0));
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(100);
+}
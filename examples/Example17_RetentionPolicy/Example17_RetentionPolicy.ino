@@ -0,0 +1,60 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to keep only the last 30 days (and at most 4GB) of logs.
+
+  We log to one file per day named LOGyymmdd.TXT. At power up the directory is listed once and the
+  dates are read from the file names. Old logs are then removed a few at a time from loop() with a
+  time budget so logging is never held up by a big cleanup.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogRetention.h"
+OpenLog myLog; //Create instance
+OpenLogRetention retention;
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Retention Example");
+
+  //Normally the date would come from an RTC or GPS
+  myLog.append("LOG181023.TXT");
+
+  retention.begin(myLog);
+  retention.inventory("LOG*.TXT");
+  retention.setToday(OpenLogRetention::dayNumber(2018, 10, 23));
+  retention.setMaxAge(30); //Days
+  retention.setMaxKilobytes(4000000UL); //About 4GB
+
+  Serial.print("Found ");
+  Serial.print(retention.getEntryCount());
+  Serial.print(" logs using ");
+  Serial.print(retention.getTotalKilobytes());
+  Serial.println("kB");
+}
+
+void loop()
+{
+  myLog.print(millis());
+  myLog.print(",");
+  myLog.println(analogRead(A0));
+
+  //Spend up to 5ms per loop removing old logs
+  retention.service(5);
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(100);
+}
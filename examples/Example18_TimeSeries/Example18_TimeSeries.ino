@@ -0,0 +1,82 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to record readings into hourly files and read back a time range.
+
+  Readings are stored in the TSDATA directory with one file per hour. An index file records where each
+  10 minute period starts in each file so a query only reads the bytes it needs.
+
+  Timestamps are in seconds. Here we use millis() but an RTC or GPS time works the same way.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogTimeSeries.h"
+OpenLog myLog; //Create instance
+OpenLogTimeSeries timeSeries;
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+#define CHANNELS 8
+
+uint8_t queryBuffer[64]; //Must hold at least one record as stored: 5 bytes + the data, doubled if every byte is 0x1A
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Time Series Example");
+
+  timeSeries.begin(myLog, "TSDATA");
+
+  //Record 20 seconds of readings
+  for (int x = 0 ; x < 200 ; x++)
+  {
+    int16_t readings[CHANNELS];
+    for (int channel = 0 ; channel < CHANNELS ; channel++)
+      readings[channel] = analogRead(A0);
+
+    timeSeries.record(millis() / 1000, (uint8_t *)readings, sizeof(readings));
+    delay(100);
+  }
+
+  //Read back the readings between 5 and 10 seconds
+  uint32_t found = timeSeries.query(5, 10, queryBuffer, sizeof(queryBuffer), printRecord);
+  Serial.print("Records found: ");
+  Serial.println(found);
+
+  timeSeries.close();
+  Serial.println("Done!");
+}
+
+void loop()
+{
+  //Blink the Status LED because we're done!
+  digitalWrite(ledPin, HIGH);
+  delay(100);
+  digitalWrite(ledPin, LOW);
+  delay(1000);
+}
+
+//Called by query() for each record in the range
+void printRecord(uint32_t timestamp, const uint8_t *data, uint8_t length)
+{
+  Serial.print(timestamp);
+  Serial.print(": ");
+  const int16_t *readings = (const int16_t *)data;
+  for (uint8_t channel = 0 ; channel < length / 2 ; channel++)
+  {
+    Serial.print(readings[channel]);
+    Serial.print(" ");
+  }
+  Serial.println();
+}
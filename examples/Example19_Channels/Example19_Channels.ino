@@ -0,0 +1,49 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how several parts of a sketch can log to one file without switching files.
+
+  Switching between files with append() costs a command every time. Instead each part of the sketch
+  gets a channel. Every line is tagged with the channel's ID, like this:
+
+  G:$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M
+  T:23.5
+
+  On your computer, extras/tools/qol_demux splits the log back into one file per channel.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogChannel.h"
+OpenLog myLog; //Create instance
+OpenLogChannel gpsLog(myLog, 'G');
+OpenLogChannel temperatureLog(myLog, 'T');
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Channels Example");
+
+  myLog.append("shared.txt");
+}
+
+void loop()
+{
+  gpsLog.println("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M");
+  temperatureLog.println(analogRead(A0) * 0.1, 1);
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(1000);
+}
@@ -0,0 +1,72 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to log to two separate files without switching files on every line.
+
+  OpenLog records to one file at a time. Alternating lines between two files normally costs an append
+  command for every line. Staged files hold lines in a buffer until the buffer is full and then send them
+  all at once, so OpenLog only switches files once every few hundred bytes.
+
+  After each buffer is sent OpenLog is switched back to the file it was recording to, so the sketch's
+  own log needs a name (see append()).
+
+  Remember to flush() staged files before power down.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogStagedFile.h"
+OpenLog myLog; //Create instance
+
+uint8_t temperatureBuffer[256];
+uint8_t humidityBuffer[256];
+OpenLogStagedFile temperatureLog(myLog, "temp.txt", temperatureBuffer, sizeof(temperatureBuffer));
+OpenLogStagedFile humidityLog(myLog, "humid.txt", humidityBuffer, sizeof(humidityBuffer));
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Staged Files Example");
+
+  myLog.append("events.txt"); //Our own log. Staged files switch back to it after each buffer.
+
+  for (int x = 0 ; x < 500 ; x++)
+  {
+    temperatureLog.print(millis());
+    temperatureLog.print(",");
+    temperatureLog.println(analogRead(A0));
+
+    humidityLog.print(millis());
+    humidityLog.print(",");
+    humidityLog.println(analogRead(A0));
+  }
+
+  temperatureLog.flush();
+  humidityLog.flush();
+  myLog.println("Staged files flushed"); //Goes to events.txt
+
+  Serial.print("File switches for 1000 lines: ");
+  Serial.println(temperatureLog.getSwitchCount() + humidityLog.getSwitchCount());
+  Serial.println("Done!");
+}
+
+void loop()
+{
+  //Blink the Status LED because we're done!
+  digitalWrite(ledPin, HIGH);
+  delay(100);
+  digitalWrite(ledPin, LOW);
+  delay(1000);
+}
@@ -0,0 +1,58 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to use log levels.
+
+  QOL_DEBUG, QOL_INFO, QOL_WARN and QOL_ERROR record a line tagged with its level (D, I, W, E).
+  Levels below QOL_COMPILE_LEVEL are removed when the sketch is compiled so they cost nothing, not even
+  working out what would have been logged. Change QOL_LEVEL_DEBUG to QOL_LEVEL_WARN below for a
+  production build.
+
+  Each part of the sketch (module) can also have its own level that can be changed while running.
+*/
+
+#define QOL_COMPILE_LEVEL QOL_LEVEL_DEBUG //Must come before the library is included
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+OpenLog myLog; //Create instance
+
+//Modules can be numbered 0 to 7
+#define MODULE_MAIN 0
+#define MODULE_SENSOR 1
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Log Levels Example");
+
+  QOL_INFO(myLog, MODULE_MAIN, F("Starting up"));
+
+  //The sensor is noisy. Only record its warnings and errors.
+  myLog.setLevel(MODULE_SENSOR, QOL_LEVEL_WARN);
+}
+
+void loop()
+{
+  int reading = analogRead(A0);
+
+  QOL_DEBUG(myLog, MODULE_SENSOR, reading); //Not recorded: below this module's level
+  if (reading > 1000)
+    QOL_WARN(myLog, MODULE_SENSOR, F("Reading near the top of the range"));
+
+  QOL_DEBUG(myLog, MODULE_MAIN, millis());
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(1000);
+}
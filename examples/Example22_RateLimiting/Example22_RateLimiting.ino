@@ -0,0 +1,65 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to keep a noisy part of a sketch from filling the card.
+
+  A module can be given a rate limit: a number of lines per second plus a burst that can be saved up.
+  Lines over the limit are dropped before they are formatted so they cost almost nothing. The number of
+  dropped lines is recorded once the module is allowed to log again.
+
+  A module can also have duplicates suppressed. When the same QOL_ line logs the same thing over and over
+  only the first one is recorded, followed by "last message repeated N times" when a different line comes
+  along. The same line with a new value is still recorded.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+OpenLog myLog; //Create instance
+
+//Modules can be numbered 0 to 7
+#define MODULE_MAIN 0
+#define MODULE_SENSOR 1
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Rate Limiting Example");
+
+  //Record at most 2 sensor readings per second, with bursts of up to 5
+  myLog.setRateLimit(MODULE_SENSOR, 2, 5);
+
+  //Only record a sensor error once until something else happens
+  myLog.setDuplicateSuppression(MODULE_SENSOR, true);
+
+  QOL_INFO(myLog, MODULE_MAIN, F("Starting up"));
+}
+
+void loop()
+{
+  int reading = analogRead(A0);
+
+  if (reading == 0)
+    QOL_ERROR(myLog, MODULE_SENSOR, F("Sensor not connected"));
+  else
+    QOL_INFO(myLog, MODULE_SENSOR, reading);
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(50);
+
+  if (millis() % 10000 < 50)
+  {
+    Serial.print("Lines suppressed: ");
+    Serial.println(myLog.getStats().suppressedLines);
+  }
+}
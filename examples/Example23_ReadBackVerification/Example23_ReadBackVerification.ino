@@ -0,0 +1,78 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to check that the SD card holds what we sent.
+
+  With verification on, the library keeps a checksum of everything written to the log and a copy of a
+  few bytes from a random spot. After a sync those bytes are read back and compared. Checking after
+  every sync costs one small read command; checking every 10th sync costs a tenth of that.
+
+  verifyFile() reads the whole log back and compares the checksum. It is slow so it's best done once,
+  when the log is finished.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+OpenLog myLog; //Create instance
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+unsigned long lastSync = 0;
+int linesLogged = 0;
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Read Back Verification Example");
+
+  randomSeed(analogRead(A0)); //Sample spots are picked with random()
+
+  myLog.setVerification(1, 16); //Check 16 bytes after every sync
+  myLog.append("VERIFY.TXT"); //Verification needs a named log so it can be read back
+}
+
+void loop()
+{
+  myLog.print("Reading: ");
+  myLog.println(analogRead(A0));
+  linesLogged++;
+
+  if (millis() - lastSync > 1000)
+  {
+    lastSync = millis();
+    if (myLog.sync() == false)
+      Serial.println("Sync or read back failed!");
+
+    OpenLogStats stats = myLog.getStats();
+    Serial.print("Checks: ");
+    Serial.print(stats.verifyCount);
+    Serial.print(" Failures: ");
+    Serial.print(stats.verifyFailures);
+    if (stats.verifyCount > 0)
+    {
+      Serial.print(" Average check (us): ");
+      Serial.print(stats.verifyMicros / stats.verifyCount);
+    }
+    Serial.println();
+  }
+
+  if (linesLogged == 1000)
+  {
+    if (myLog.verifyFile() == true)
+      Serial.println("The whole log checks out");
+    else
+      Serial.println("The log doesn't match what we sent!");
+  }
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(20);
+}
@@ -0,0 +1,71 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to record sync markers so logs from several loggers can be merged.
+
+  Two OpenLogs (one changed to address 0x2B with Example11) are put in an OpenLogArray. Once a second
+  the array records "!SYNC <id> <millis>" on both. On your computer:
+
+    qol_merge -s LOG1.TXT LOG2.TXT > merged.txt
+
+  fits each log's clock to the first log's clock using the markers and merges the logs in time order.
+  The tool is in extras/tools.
+
+  When the loggers are on different boards, call writeSyncMarker(id) on each board with the same ID
+  when a shared event happens (a GPS pulse per second, a trigger line, etc).
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogArray.h"
+
+OpenLog engineLog;
+OpenLog cabinLog;
+OpenLogArray allLogs;
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+unsigned long lastMarker = 0;
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  engineLog.begin(); //Default address 0x2A
+  cabinLog.begin(0x2B);
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Sync Markers Example");
+
+  //The merge tool needs a timestamp on every line
+  engineLog.setTimestamps(true);
+  cabinLog.setTimestamps(true);
+
+  allLogs.add(engineLog);
+  allLogs.add(cabinLog);
+  allLogs.println("Logging started"); //Goes to both
+}
+
+void loop()
+{
+  engineLog.print("Engine temp: ");
+  engineLog.println(analogRead(A0));
+
+  cabinLog.print("Cabin temp: ");
+  cabinLog.println(analogRead(A1));
+
+  if (millis() - lastMarker > 1000)
+  {
+    lastMarker = millis();
+    if (allLogs.writeSyncMarker() == false)
+      Serial.println("Sync marker failed");
+  }
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(100);
+}
@@ -0,0 +1,102 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to mirror a log onto several OpenLogs with one transaction per chunk.
+
+  Normally an OpenLogArray sends each chunk to every OpenLog in turn, so three mirrors take three times
+  the bus time. In broadcast mode each chunk is sent once to the I2C general call address and every
+  OpenLog records it. Your OpenLog firmware must have general call enabled for this to work. Firmware
+  that has it reports QOL_FEATURE_GENERAL_CALL and setBroadcast() checks every mirror for it.
+
+  The sketch writes the same lines both ways, prints how long each took, and then checks every
+  mirror has everything that was broadcast.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogArray.h"
+
+OpenLog mirrorA;
+OpenLog mirrorB;
+OpenLog mirrorC;
+OpenLogArray mirrors;
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+#define LINES_TO_WRITE 100
+
+//Write some lines to the mirrors and return how long it took
+unsigned long writeLines()
+{
+  unsigned long startTime = micros();
+  for (int x = 0 ; x < LINES_TO_WRITE ; x++)
+  {
+    mirrors.print("Line ");
+    mirrors.print(x);
+    mirrors.println(": The quick brown fox jumps over the lazy dog");
+  }
+  return (micros() - startTime);
+}
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Broadcast Mirroring Example");
+
+  //Each mirror needs its own address (see Example11) and a named log so it can be checked
+  mirrorA.begin(0x2A);
+  mirrorB.begin(0x2B);
+  mirrorC.begin(0x2C);
+  mirrorA.append("MIRROR.TXT");
+  mirrorB.append("MIRROR.TXT");
+  mirrorC.append("MIRROR.TXT");
+
+  mirrors.add(mirrorA);
+  mirrors.add(mirrorB);
+  mirrors.add(mirrorC);
+
+  unsigned long oneByOne = writeLines();
+  Serial.print("Sent to each mirror in turn (us): ");
+  Serial.println(oneByOne);
+
+  if (mirrors.setBroadcast(true) == false)
+  {
+    Serial.println("Every mirror needs general call firmware and a named log. Freezing.");
+    while (1);
+  }
+
+  unsigned long broadcast = writeLines();
+  Serial.print("Broadcast to all mirrors (us): ");
+  Serial.println(broadcast);
+
+  uint8_t missing = mirrors.verifyMirrors();
+  if (missing == 0)
+    Serial.println("Every mirror has everything");
+  else
+  {
+    for (uint8_t x = 0 ; x < mirrors.count() ; x++)
+    {
+      if (missing & (1 << x))
+      {
+        Serial.print("Mirror ");
+        Serial.print(x);
+        Serial.println(" is missing data");
+      }
+    }
+  }
+}
+
+void loop()
+{
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(500);
+}
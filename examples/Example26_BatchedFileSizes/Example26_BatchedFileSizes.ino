@@ -0,0 +1,94 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to read the sizes of many files quickly.
+
+  Calling size() in a loop builds a String command for every file. Passing the whole list of names to
+  size() sends the commands and reads the answers back to back without making any copies of the names.
+
+  The sketch makes a directory of test files, lists it, then times both ways of reading the sizes.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+OpenLog myLog; //Create instance
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+#define FILE_COUNT 20
+
+char names[FILE_COUNT][13]; //8.3 names
+const char *namePointers[FILE_COUNT];
+int32_t fileSizes[FILE_COUNT];
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Batched File Sizes Example");
+
+  //Make some files to look at
+  myLog.makeDirectory("SIZES");
+  myLog.changeDirectory("SIZES");
+  for (int x = 0 ; x < FILE_COUNT ; x++)
+  {
+    myLog.append("FILE" + String(x) + ".TXT");
+    for (int y = 0 ; y <= x ; y++)
+      myLog.println("Some data");
+  }
+  myLog.sync();
+
+  //Get the names from the directory listing
+  int fileCount = 0;
+  myLog.searchDirectory("*.TXT");
+  String fileName = myLog.getNextDirectoryItem();
+  while (fileName != "" && fileCount < FILE_COUNT)
+  {
+    fileName.toCharArray(names[fileCount], sizeof(names[fileCount]));
+    namePointers[fileCount] = names[fileCount];
+    fileCount++;
+    fileName = myLog.getNextDirectoryItem();
+  }
+
+  //One at a time
+  unsigned long startTime = micros();
+  for (int x = 0 ; x < fileCount ; x++)
+    fileSizes[x] = myLog.size(names[x]);
+  unsigned long oneAtATime = micros() - startTime;
+
+  //All at once
+  startTime = micros();
+  int found = myLog.size(namePointers, fileCount, fileSizes);
+  unsigned long batched = micros() - startTime;
+
+  for (int x = 0 ; x < fileCount ; x++)
+  {
+    Serial.print(names[x]);
+    Serial.print(": ");
+    Serial.println(fileSizes[x]);
+  }
+
+  Serial.print("Files found: ");
+  Serial.println(found);
+  Serial.print("size() in a loop (us): ");
+  Serial.println(oneAtATime);
+  Serial.print("Batched size() (us): ");
+  Serial.println(batched);
+
+  myLog.changeDirectory("..");
+}
+
+void loop()
+{
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(500);
+}
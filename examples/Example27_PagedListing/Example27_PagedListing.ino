@@ -0,0 +1,71 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to list a large directory a few names at a time.
+
+  searchDirectory() and getNextDirectoryItem() must finish the listing before any other command is
+  sent. listPage() hands out a page of names at a time and remembers where it was in a cursor, so
+  between pages you can read sizes, remove files, or carry on logging. If another command was sent the
+  listing is started again and skips ahead to the first name it hasn't handed out yet, found by name.
+
+  Firmware with QOL_FEATURE_LS_SKIP skips ahead itself, so that costs one read. Older firmware reads
+  the names ahead of the page again, so on a big directory use bigger pages.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+OpenLog myLog; //Create instance
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+#define PAGE_SIZE 4
+
+OpenLogListCursor cursor;
+OpenLogName names[PAGE_SIZE];
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Paged Listing Example");
+
+  myLog.startListing(cursor, "*.TXT");
+}
+
+void loop()
+{
+  //Do one page each time through loop() so other work isn't held up
+  uint8_t count = myLog.listPage(cursor, names, PAGE_SIZE);
+  if (count > 0)
+  {
+    //Read the sizes of this page. This is a command so the listing will pick up its place next time.
+    const char *namePointers[PAGE_SIZE];
+    int32_t fileSizes[PAGE_SIZE];
+    for (uint8_t x = 0 ; x < count ; x++)
+      namePointers[x] = names[x];
+    myLog.size(namePointers, count, fileSizes);
+
+    for (uint8_t x = 0 ; x < count ; x++)
+    {
+      Serial.print(names[x]);
+      Serial.print("\t");
+      Serial.println(fileSizes[x]);
+    }
+  }
+  else if (cursor.done == true)
+  {
+    Serial.println("Listing done");
+    while (1);
+  }
+
+  digitalWrite(ledPin, !digitalRead(ledPin)); //Blink the Status LED as we go
+  delay(100);
+}
@@ -0,0 +1,80 @@
+/*
+  An I2C based datalogger - Like the OpenLog but for I2C
+  By: Nathan Seidle
+  SparkFun Electronics
+  Date: February 2nd, 2018
+  License: This code is public domain but you buy me a beer if you use this and we meet someday (Beerware license).
+
+  This example shows how to remove a large directory without stopping the logging.
+
+  removeDirectory() waits until OpenLog has removed every file, which for an old directory of
+  thousands of logs can take many seconds. OpenLogRemover removes a few files each time service()
+  is called so the sketch keeps recording in between.
+*/
+
+#include <Wire.h>
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogRemover.h"
+OpenLog myLog; //Create instance
+OpenLogRemover remover;
+
+int ledPin = 13; //Status LED connected to digital pin 13
+
+void setup()
+{
+  pinMode(ledPin, OUTPUT);
+
+  Wire.begin();
+  Wire.setClock(400000); //Go super fast
+  myLog.begin(); //Open connection to OpenLog (no pun intended)
+
+  Serial.begin(9600); //9600bps is used for debug statements
+  Serial.println("OpenLog Incremental Remove Example");
+
+  //Make an OLD directory with a subdirectory and some files to remove
+  myLog.makeDirectory("OLD");
+  myLog.changeDirectory("OLD");
+  myLog.makeDirectory("DAY1");
+  for (int x = 0 ; x < 20 ; x++)
+    myLog.create("OLD" + String(x) + ".TXT");
+  myLog.changeDirectory("DAY1");
+  for (int x = 0 ; x < 20 ; x++)
+    myLog.create("DAY" + String(x) + ".TXT");
+  myLog.changeDirectory("..");
+  myLog.changeDirectory("..");
+
+  myLog.append("NEWLOG.TXT"); //Keep logging here while OLD is removed
+
+  remover.begin(myLog, "OLD");
+}
+
+void loop()
+{
+  //Record something
+  myLog.print("Time: ");
+  myLog.println(millis());
+
+  if (remover.isDone() == false)
+  {
+    remover.service(20); //Spend up to 20ms removing files
+
+    Serial.print("Working in ");
+    Serial.print(remover.getCurrentDirectory());
+    Serial.print(", removed: ");
+    Serial.println(remover.getRemovedCount());
+
+    if (remover.isDone() == true)
+    {
+      if (remover.hadError() == true)
+        Serial.println(F("OpenLog refused a command. Is the directory there?"));
+      else
+        Serial.println(F("OLD is gone!"));
+    }
+  }
+
+  //Blink the Status LED
+  digitalWrite(ledPin, HIGH);
+  delay(50);
+  digitalWrite(ledPin, LOW);
+  delay(50);
+}
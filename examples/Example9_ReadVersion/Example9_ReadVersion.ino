@@ -28,6 +28,12 @@ void setup()
   Serial.print("Qwiic OpenLog Version: ");
   Serial.println(myLog.getVersion());
 
+  //begin() asks newer firmware what it can do. The library uses these automatically.
+  Serial.print("Binary commands: ");
+  Serial.println(myLog.hasFeature(QOL_FEATURE_BINARY_COMMANDS) ? "Yes" : "No");
+  Serial.print("Packed directory listings: ");
+  Serial.println(myLog.hasFeature(QOL_FEATURE_PACKED_LS) ? "Yes" : "No");
+
   Serial.println("Done!");
 }
 
@@ -0,0 +1,174 @@
+/*
+  Check the line CRCs in a Qwiic OpenLog log.
+
+  Lines written with setLineCrc(true) end with "*XXXX" just before the line ending. XXXX is the
+  CRC-16/CCITT (polynomial 0x1021, starting at 0xFFFF) of everything on the line before the '*'.
+  Lines without a CRC are counted and skipped.
+
+  The CRC is worked out 8 bytes at a time (slicing-by-8) so large logs check at disk speed.
+
+  Build: g++ -O2 -o qol_crc qol_crc.cpp
+  Usage: qol_crc LOG00001.TXT
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+static uint16_t crcTable[8][256]; //crcTable[k][x] is the CRC of byte x followed by k zero bytes
+
+static uint64_t lines = 0;
+static uint64_t checked = 0;
+static uint64_t unchecked = 0;
+static uint64_t failed = 0;
+
+static const int failuresToList = 20;
+
+static void buildTables()
+{
+  for (int x = 0 ; x < 256 ; x++)
+  {
+    uint16_t crc = x << 8;
+    for (int bit = 0 ; bit < 8 ; bit++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    crcTable[0][x] = crc;
+  }
+
+  for (int k = 1 ; k < 8 ; k++)
+    for (int x = 0 ; x < 256 ; x++)
+      crcTable[k][x] = (crcTable[k - 1][x] << 8) ^ crcTable[0][crcTable[k - 1][x] >> 8];
+}
+
+static uint16_t crc16(uint16_t crc, const uint8_t *data, size_t length)
+{
+  while (length >= 8)
+  {
+    crc ^= (data[0] << 8) | data[1];
+    crc = crcTable[7][crc >> 8] ^ crcTable[6][crc & 0xFF] ^
+          crcTable[5][data[2]] ^ crcTable[4][data[3]] ^ crcTable[3][data[4]] ^
+          crcTable[2][data[5]] ^ crcTable[1][data[6]] ^ crcTable[0][data[7]];
+    data += 8;
+    length -= 8;
+  }
+
+  while (length-- > 0)
+    crc = (crc << 8) ^ crcTable[0][(crc >> 8) ^ *data++];
+
+  return (crc);
+}
+
+static int hexValue(char character)
+{
+  if (character >= '0' && character <= '9') return (character - '0');
+  if (character >= 'A' && character <= 'F') return (character - 'A' + 10);
+  return (-1);
+}
+
+//Check one line of the log
+static void handleLine(const char *line, size_t length, uint64_t offset)
+{
+  lines++;
+
+  //Drop the line ending
+  if (length > 0 && line[length - 1] == '\n') length--;
+  if (length > 0 && line[length - 1] == '\r') length--;
+
+  if (length < 5 || line[length - 5] != '*')
+  {
+    unchecked++;
+    return;
+  }
+
+  int expected = 0;
+  for (size_t x = length - 4 ; x < length ; x++)
+  {
+    int digit = hexValue(line[x]);
+    if (digit < 0)
+    {
+      unchecked++;
+      return;
+    }
+    expected = (expected << 4) | digit;
+  }
+
+  checked++;
+  uint16_t crc = crc16(0xFFFF, (const uint8_t *)line, length - 5);
+  if (crc != expected)
+  {
+    if (failed++ < failuresToList)
+      printf("line %llu (byte %llu): CRC is %04X, line says %04X: %.*s\n", (unsigned long long)lines,
+             (unsigned long long)offset, crc, expected, (int)length, line);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 2)
+  {
+    fprintf(stderr, "Usage: %s log.txt\n", argv[0]);
+    return (1);
+  }
+
+  FILE *input = fopen(argv[1], "rb");
+  if (input == NULL)
+  {
+    perror(argv[1]);
+    return (1);
+  }
+
+  buildTables();
+
+  //Read in large blocks and split lines in place. A line that runs off the end of a block
+  //is carried to the front of the next block.
+  const size_t blockSize = 1 << 22;
+  char *block = (char *)malloc(blockSize * 2);
+  size_t carried = 0;
+  size_t bytesRead;
+  uint64_t blockOffset = 0; //File offset of the start of the block
+
+  while ((bytesRead = fread(block + carried, 1, blockSize, input)) > 0)
+  {
+    size_t available = carried + bytesRead;
+    size_t lineStart = 0;
+
+    while (true)
+    {
+      char *newLine = (char *)memchr(block + lineStart, '\n', available - lineStart);
+      if (newLine == NULL) break;
+
+      size_t lineEnd = newLine - block + 1;
+      handleLine(block + lineStart, lineEnd - lineStart, blockOffset + lineStart);
+      lineStart = lineEnd;
+    }
+
+    carried = available - lineStart;
+    if (carried > blockSize)
+    {
+      //Not a text log. Count it rather than growing forever.
+      lines++;
+      unchecked++;
+      lineStart = available;
+      carried = 0;
+    }
+    memmove(block, block + lineStart, carried);
+    blockOffset += lineStart;
+  }
+
+  if (carried > 0)
+    handleLine(block, carried, blockOffset); //Last line had no new line
+
+  free(block);
+  fclose(input);
+
+  if (failed > failuresToList)
+    printf("(%llu more bad lines not listed)\n", (unsigned long long)(failed - failuresToList));
+
+  printf("lines: %llu\n", (unsigned long long)lines);
+  printf("checked: %llu\n", (unsigned long long)checked);
+  if (unchecked > 0)
+    printf("without a CRC: %llu\n", (unsigned long long)unchecked);
+  printf("bad: %llu\n", (unsigned long long)failed);
+
+  return (failed > 0 ? 2 : 0);
+}
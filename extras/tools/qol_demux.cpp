@@ -0,0 +1,123 @@
+/*
+  Split a channel multiplexed Qwiic OpenLog log into one file per channel.
+
+  Records written by OpenLogChannel look like:
+    <id>:<line>\n   a complete line
+    <id>+<part>\n   part of a line. The line continues in the channel's next record.
+
+  Channel X is written to <prefix>_X.txt. Lines that aren't records go to <prefix>_untagged.txt.
+
+  Build: g++ -O2 -o qol_demux qol_demux.cpp
+  Usage: qol_demux LOG00001.TXT [prefix]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+static FILE *channelFiles[256];
+static FILE *untaggedFile = NULL;
+static std::string outputPrefix;
+
+//Return the output file for a channel, opening it the first time we see the channel
+static FILE *channelFile(unsigned char id)
+{
+  if (channelFiles[id] == NULL)
+  {
+    std::string name = outputPrefix + "_" + (char)id + ".txt";
+    channelFiles[id] = fopen(name.c_str(), "wb");
+    if (channelFiles[id] == NULL)
+    {
+      perror(name.c_str());
+      exit(1);
+    }
+    setvbuf(channelFiles[id], NULL, _IOFBF, 1 << 16);
+  }
+  return (channelFiles[id]);
+}
+
+//Write one line of the input (including its new line) to the right place
+static void handleLine(const char *line, size_t length, bool complete)
+{
+  if (length >= 2 && line[0] > ' ' && line[0] < 0x7F && (line[1] == ':' || line[1] == '+'))
+  {
+    FILE *output = channelFile(line[0]);
+    size_t payload = length - 2;
+    if (line[1] == '+' && complete) payload--; //Continuation: drop the record's new line
+    fwrite(line + 2, 1, payload, output);
+    return;
+  }
+
+  if (untaggedFile == NULL)
+  {
+    std::string name = outputPrefix + "_untagged.txt";
+    untaggedFile = fopen(name.c_str(), "wb");
+    if (untaggedFile == NULL)
+    {
+      perror(name.c_str());
+      exit(1);
+    }
+  }
+  fwrite(line, 1, length, untaggedFile);
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    fprintf(stderr, "Usage: %s log.txt [prefix]\n", argv[0]);
+    return (1);
+  }
+
+  FILE *input = fopen(argv[1], "rb");
+  if (input == NULL)
+  {
+    perror(argv[1]);
+    return (1);
+  }
+  outputPrefix = (argc > 2) ? argv[2] : "channel";
+
+  //Read in large blocks and split lines in place. A line that runs off the end of a block
+  //is carried to the front of the next block.
+  const size_t blockSize = 1 << 20;
+  char *block = (char *)malloc(blockSize * 2);
+  size_t carried = 0;
+  size_t bytesRead;
+
+  while ((bytesRead = fread(block + carried, 1, blockSize, input)) > 0)
+  {
+    size_t available = carried + bytesRead;
+    size_t lineStart = 0;
+
+    while (true)
+    {
+      char *newLine = (char *)memchr(block + lineStart, '\n', available - lineStart);
+      if (newLine == NULL) break;
+
+      size_t lineEnd = newLine - block + 1;
+      handleLine(block + lineStart, lineEnd - lineStart, true);
+      lineStart = lineEnd;
+    }
+
+    carried = available - lineStart;
+    if (carried > blockSize)
+    {
+      //Something that isn't a record log. Pass it through rather than growing forever.
+      handleLine(block + lineStart, carried, false);
+      carried = 0;
+    }
+    memmove(block, block + lineStart, carried);
+  }
+
+  if (carried > 0)
+    handleLine(block, carried, false); //Last line had no new line
+
+  for (int x = 0 ; x < 256 ; x++)
+    if (channelFiles[x] != NULL) fclose(channelFiles[x]);
+  if (untaggedFile != NULL) fclose(untaggedFile);
+
+  free(block);
+  fclose(input);
+  return (0);
+}
@@ -0,0 +1,258 @@
+/*
+  Check the sequence numbers in a Qwiic OpenLog log for lost, repeated, and reordered records.
+
+  Text logs: lines written with setSequenceNumbers(true) start with "#<sequence> ". Lines without
+  a sequence number are counted and skipped.
+
+  Binary logs: fixed size records with a 4 byte little endian sequence number at a known offset,
+  usually taken from nextSequenceNumber(). Use -b <record size> <offset of sequence number>.
+
+  A sequence number of 0 after other numbers means the logger was restarted. Each restart begins a
+  new run and is checked on its own.
+
+  Build: g++ -O2 -o qol_gaps qol_gaps.cpp
+  Usage: qol_gaps LOG00001.TXT
+         qol_gaps -b 16 0 DATA.BIN
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <map>
+
+struct Gap
+{
+  uint32_t end; //One past the last missing number
+  uint64_t offset; //Where in the file the record after the gap starts
+};
+
+static std::map<uint32_t, Gap> openGaps; //Missing numbers in the current run, by first missing number
+static bool runStarted = false;
+static uint32_t expected = 0; //Number we expect next
+
+static uint64_t records = 0;
+static uint64_t unnumbered = 0;
+static uint64_t runs = 0;
+static uint64_t gapsFound = 0;
+static uint64_t duplicates = 0;
+static uint64_t reordered = 0;
+static uint64_t missing = 0; //Numbers that never showed up
+static uint64_t missingGaps = 0;
+
+static const int gapsToList = 20;
+static int gapsListed = 0;
+
+//Report the numbers that never showed up in the run that just ended
+static void endRun()
+{
+  for (std::map<uint32_t, Gap>::iterator gap = openGaps.begin() ; gap != openGaps.end() ; gap++)
+  {
+    missing += gap->second.end - gap->first;
+    missingGaps++;
+    if (gapsListed++ < gapsToList)
+      printf("run %llu: missing %u to %u (%u record(s)) before byte %llu\n", (unsigned long long)runs,
+             gap->first, gap->second.end - 1, gap->second.end - gap->first, (unsigned long long)gap->second.offset);
+  }
+  openGaps.clear();
+  runStarted = false;
+}
+
+static void handleSequence(uint32_t sequence, uint64_t offset)
+{
+  records++;
+
+  if (runStarted == true && sequence == 0 && expected > 1)
+    endRun(); //Logger restarted
+
+  if (runStarted == false)
+  {
+    runStarted = true;
+    runs++;
+    expected = sequence + 1;
+    return;
+  }
+
+  if (sequence == expected)
+  {
+    expected++;
+    return;
+  }
+
+  if (sequence > expected)
+  {
+    Gap gap = {sequence, offset};
+    openGaps[expected] = gap;
+    gapsFound++;
+    expected = sequence + 1;
+    return;
+  }
+
+  //Older than expected: either it fills a gap (reordered) or we've seen it (duplicate)
+  std::map<uint32_t, Gap>::iterator gap = openGaps.upper_bound(sequence);
+  if (gap != openGaps.begin())
+  {
+    gap--;
+    if (sequence < gap->second.end)
+    {
+      reordered++;
+
+      uint32_t start = gap->first;
+      Gap rest = gap->second;
+      openGaps.erase(gap);
+      if (sequence > start)
+      {
+        Gap before = {sequence, rest.offset};
+        openGaps[start] = before;
+      }
+      if (sequence + 1 < rest.end)
+        openGaps[sequence + 1] = rest;
+      return;
+    }
+  }
+  duplicates++;
+}
+
+//Check one line of a text log
+static void handleLine(const char *line, size_t length, uint64_t offset)
+{
+  if (length < 3 || line[0] != '#' || line[1] < '0' || line[1] > '9')
+  {
+    unnumbered++;
+    return;
+  }
+
+  uint32_t sequence = 0;
+  size_t spot = 1;
+  while (spot < length && line[spot] >= '0' && line[spot] <= '9')
+    sequence = sequence * 10 + (line[spot++] - '0');
+
+  if (spot == length || line[spot] != ' ')
+  {
+    unnumbered++;
+    return;
+  }
+  handleSequence(sequence, offset);
+}
+
+static void scanText(FILE *input)
+{
+  //Read in large blocks and split lines in place. A line that runs off the end of a block
+  //is carried to the front of the next block.
+  const size_t blockSize = 1 << 22;
+  char *block = (char *)malloc(blockSize * 2);
+  size_t carried = 0;
+  size_t bytesRead;
+  uint64_t blockOffset = 0; //File offset of the start of the block
+
+  while ((bytesRead = fread(block + carried, 1, blockSize, input)) > 0)
+  {
+    size_t available = carried + bytesRead;
+    size_t lineStart = 0;
+
+    while (true)
+    {
+      char *newLine = (char *)memchr(block + lineStart, '\n', available - lineStart);
+      if (newLine == NULL) break;
+
+      size_t lineEnd = newLine - block + 1;
+      handleLine(block + lineStart, lineEnd - lineStart, blockOffset + lineStart);
+      lineStart = lineEnd;
+    }
+
+    carried = available - lineStart;
+    if (carried > blockSize)
+    {
+      //Not a text log. Count it rather than growing forever.
+      unnumbered++;
+      lineStart = available;
+      carried = 0;
+    }
+    memmove(block, block + lineStart, carried);
+    blockOffset += lineStart;
+  }
+
+  if (carried > 0)
+    handleLine(block, carried, blockOffset); //Last line had no new line
+
+  free(block);
+}
+
+static void scanBinary(FILE *input, size_t recordSize, size_t sequenceOffset)
+{
+  size_t recordsPerBlock = (1 << 22) / recordSize;
+  if (recordsPerBlock == 0) recordsPerBlock = 1;
+  uint8_t *block = (uint8_t *)malloc(recordsPerBlock * recordSize);
+  uint64_t offset = 0;
+  size_t bytesRead;
+
+  while ((bytesRead = fread(block, 1, recordsPerBlock * recordSize, input)) > 0)
+  {
+    size_t count = bytesRead / recordSize; //A torn record at the end of the file is ignored
+    for (size_t x = 0 ; x < count ; x++)
+    {
+      const uint8_t *field = block + x * recordSize + sequenceOffset;
+      uint32_t sequence = field[0] | (field[1] << 8) | (field[2] << 16) | ((uint32_t)field[3] << 24);
+      handleSequence(sequence, offset);
+      offset += recordSize;
+    }
+    if (bytesRead % recordSize != 0)
+      unnumbered++;
+  }
+
+  free(block);
+}
+
+int main(int argc, char **argv)
+{
+  size_t recordSize = 0;
+  size_t sequenceOffset = 0;
+  int fileArgument = 1;
+
+  if (argc == 5 && strcmp(argv[1], "-b") == 0)
+  {
+    recordSize = strtoul(argv[2], NULL, 10);
+    sequenceOffset = strtoul(argv[3], NULL, 10);
+    fileArgument = 4;
+    if (recordSize == 0 || sequenceOffset + 4 > recordSize)
+    {
+      fprintf(stderr, "The sequence number must fit inside the record\n");
+      return (1);
+    }
+  }
+  else if (argc != 2)
+  {
+    fprintf(stderr, "Usage: %s log.txt\n       %s -b <record size> <sequence offset> log.bin\n", argv[0], argv[0]);
+    return (1);
+  }
+
+  FILE *input = fopen(argv[fileArgument], "rb");
+  if (input == NULL)
+  {
+    perror(argv[fileArgument]);
+    return (1);
+  }
+
+  if (recordSize > 0)
+    scanBinary(input, recordSize, sequenceOffset);
+  else
+    scanText(input);
+  fclose(input);
+
+  endRun();
+  if (gapsListed > gapsToList)
+    printf("(%d more gaps not listed)\n", gapsListed - gapsToList);
+
+  printf("records: %llu in %llu run(s)\n", (unsigned long long)records, (unsigned long long)runs);
+  if (unnumbered > 0)
+    printf("lines without a sequence number: %llu\n", (unsigned long long)unnumbered);
+  printf("missing: %llu records in %llu gap(s)", (unsigned long long)missing, (unsigned long long)missingGaps);
+  if (records + missing > 0)
+    printf(" (%.4f%% lost)", 100.0 * missing / (records + missing));
+  printf("\n");
+  printf("gaps seen while reading: %llu\n", (unsigned long long)gapsFound);
+  printf("reordered: %llu\n", (unsigned long long)reordered);
+  printf("duplicates: %llu\n", (unsigned long long)duplicates);
+
+  return ((missing > 0 || duplicates > 0) ? 2 : 0);
+}
@@ -0,0 +1,427 @@
+/*
+  Merge the logs from several Qwiic OpenLogs into one log in timestamp order.
+
+  Text logs need lines written with setTimestamps(true): "seconds.milliseconds " at the start of each
+  line, after the "#<sequence> " if sequence numbers are on. A line without a timestamp stays with the
+  line before it. Time-series partitions (*.TS from OpenLogTimeSeries) are read as binary records and
+  written out as "seconds.000 " followed by the data in hex. The 0x00 stored after each 0x1A byte in a
+  partition is taken out.
+
+  Each log is read through its own fixed size buffer and a heap picks the earliest line across the
+  logs, so memory use doesn't grow with the size of the logs.
+
+  With -s the "!SYNC <id> <millis>" lines written by OpenLogArray::writeSyncMarker() are used to put
+  every log on the clock of the first log. Markers with the same ID are taken to have happened at the
+  same moment. A straight line (offset and drift) is fitted to each log's marker times, the fit is
+  reported, and the timestamps in the merged output are corrected. This takes an extra pass over the logs.
+
+  Build: g++ -O2 -o qol_merge qol_merge.cpp
+  Usage: qol_merge [-l] [-s] LOG1.TXT LOG2.TXT ... > merged.txt
+    -l  start each line with the name of the log it came from
+    -s  correct each log's clock using sync markers
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <math.h>
+#include <map>
+#include <queue>
+#include <vector>
+
+static const size_t blockSize = 1 << 20;
+
+struct Source
+{
+  const char *name;
+  FILE *file;
+  bool binary; //Time-series partition
+  char *block;
+  size_t start; //Start of the unread data in the block
+  size_t used; //Bytes in the block
+  bool endOfFile;
+
+  //The record waiting to be merged
+  const char *record;
+  size_t length;
+  size_t stored; //Bytes the record took in the file. More than length when stuffing was taken out.
+  uint64_t time; //Milliseconds, on the first log's clock when -s is used
+  bool hasTimestamp; //The record has its own timestamp, from timeStart to timeEnd
+  size_t timeStart;
+  size_t timeEnd;
+
+  //Clock correction found from the sync markers: time = slope * local time + offset
+  double slope;
+  double offset;
+  std::map<uint32_t, double> markers; //Local time of each marker by ID
+};
+
+//Entries in the heap. The earliest time comes out first. Ties go to the earlier log on the command line.
+struct Pending
+{
+  uint64_t time;
+  size_t source;
+  bool operator<(const Pending &other) const
+  {
+    if (time != other.time) return (time > other.time);
+    return (source > other.source);
+  }
+};
+
+//Make sure at least 'needed' bytes are in the block (unless the file ends first)
+static size_t fill(Source &source, size_t needed)
+{
+  if (source.used - source.start >= needed || source.endOfFile == true)
+    return (source.used - source.start);
+
+  memmove(source.block, source.block + source.start, source.used - source.start);
+  source.used -= source.start;
+  source.start = 0;
+
+  while (source.used < needed && source.endOfFile == false)
+  {
+    size_t bytesRead = fread(source.block + source.used, 1, blockSize - source.used, source.file);
+    if (bytesRead == 0) source.endOfFile = true;
+    source.used += bytesRead;
+  }
+  return (source.used - source.start);
+}
+
+//Read "seconds.milliseconds " from the start of a line, skipping "#<sequence> " if it's there
+//timeStart is set to where the timestamp is, or would be, and timeEnd to the first byte after it
+static bool parseTimestamp(const char *line, size_t length, uint64_t &time, size_t &timeStart, size_t &timeEnd)
+{
+  size_t spot = 0;
+  if (length > 0 && line[0] == '#')
+  {
+    spot++;
+    while (spot < length && line[spot] >= '0' && line[spot] <= '9') spot++;
+    if (spot == length || line[spot] != ' ') spot = 0; //Not a sequence number after all
+    else spot++;
+  }
+  timeStart = spot;
+  timeEnd = spot;
+
+  uint64_t seconds = 0;
+  size_t digits = 0;
+  while (spot < length && line[spot] >= '0' && line[spot] <= '9')
+  {
+    seconds = seconds * 10 + (line[spot++] - '0');
+    digits++;
+  }
+  if (digits == 0 || spot + 4 >= length || line[spot] != '.') return (false);
+
+  uint64_t milliseconds = 0;
+  for (int x = 1 ; x <= 3 ; x++)
+  {
+    char character = line[spot + x];
+    if (character < '0' || character > '9') return (false);
+    milliseconds = milliseconds * 10 + (character - '0');
+  }
+  if (line[spot + 4] != ' ') return (false);
+
+  time = seconds * 1000 + milliseconds;
+  timeEnd = spot + 5;
+  return (true);
+}
+
+//Put a local time on the first log's clock
+static uint64_t correctTime(const Source &source, uint64_t localTime)
+{
+  double time = source.slope * localTime + source.offset;
+  if (time < 0) return (0);
+  return ((uint64_t)(time + 0.5));
+}
+
+//Move a log on to its next record. Returns false at the end of the log.
+static bool nextRecord(Source &source)
+{
+  source.start += source.stored; //Done with the last record
+  source.length = 0;
+  source.stored = 0;
+
+  if (source.binary == true)
+  {
+    //Every 0x1A is followed by a 0x00 so a record takes at most twice its length
+    size_t available = fill(source, 2 * (5 + 255));
+    uint8_t *record = (uint8_t *)source.block + source.start;
+    size_t spot = 0;
+    size_t recordLength = 0;
+    size_t needed = 5;
+
+    //Take the stuffing out in place
+    while (recordLength < needed)
+    {
+      if (spot == available) return (false); //Torn record at the end
+      uint8_t incoming = record[spot++];
+      if (incoming == 0x1A)
+      {
+        if (spot == available) return (false);
+        spot++;
+      }
+      record[recordLength++] = incoming;
+      if (recordLength == 5) needed += record[4];
+    }
+
+    source.record = (const char *)record;
+    source.length = recordLength;
+    source.stored = spot;
+    source.time = (uint64_t)(record[0] | (record[1] << 8) | (record[2] << 16) | ((uint32_t)record[3] << 24)) * 1000;
+    return (true);
+  }
+
+  char *newLine = (char *)memchr(source.block + source.start, '\n', source.used - source.start);
+  if (newLine == NULL)
+  {
+    size_t available = fill(source, blockSize);
+    if (available == 0) return (false);
+    newLine = (char *)memchr(source.block + source.start, '\n', available);
+  }
+
+  //A line longer than the block, or the last line without a new line, is taken as it is
+  if (newLine != NULL) source.length = newLine - (source.block + source.start) + 1;
+  else source.length = source.used - source.start;
+  source.stored = source.length;
+  source.record = source.block + source.start;
+
+  uint64_t time;
+  source.hasTimestamp = parseTimestamp(source.record, source.length, time, source.timeStart, source.timeEnd);
+  if (source.hasTimestamp == true)
+    source.time = correctTime(source, time);
+  //Otherwise keep the time of the line before so the line stays with it
+  return (true);
+}
+
+static void writeRecord(const Source &source, bool label, FILE *output)
+{
+  if (label == true)
+  {
+    fputs(source.name, output);
+    fputs(": ", output);
+  }
+
+  if (source.binary == false)
+  {
+    if (source.hasTimestamp == true && (source.slope != 1.0 || source.offset != 0.0))
+    {
+      //Swap in the corrected timestamp
+      fwrite(source.record, 1, source.timeStart, output);
+      fprintf(output, "%llu.%03u ", (unsigned long long)(source.time / 1000), (unsigned)(source.time % 1000));
+      fwrite(source.record + source.timeEnd, 1, source.length - source.timeEnd, output);
+      return;
+    }
+    fwrite(source.record, 1, source.length, output);
+    if (source.record[source.length - 1] != '\n') fputc('\n', output);
+    return;
+  }
+
+  static const char hex[] = "0123456789ABCDEF";
+  const uint8_t *data = (const uint8_t *)source.record + 5;
+  char text[2 * 255 + 1];
+  for (size_t x = 0 ; x < source.length - 5 ; x++)
+  {
+    text[x * 2] = hex[data[x] >> 4];
+    text[x * 2 + 1] = hex[data[x] & 0x0F];
+  }
+  text[(source.length - 5) * 2] = '\0';
+  fprintf(output, "%llu.000 %s\n", (unsigned long long)(source.time / 1000), text);
+}
+
+//First pass: find every "!SYNC <id> <millis>" line and note the local time it was recorded
+//The line's timestamp is used if it has one as that is the clock we'll be correcting
+static void findMarkers(Source &source)
+{
+  source.length = 0;
+  while (nextRecord(source) == true)
+  {
+    const char *line = source.record;
+    size_t length = source.length;
+    size_t spot = source.timeEnd;
+    if (length - spot < 7 || memcmp(line + spot, "!SYNC ", 6) != 0) continue;
+
+    char text[64];
+    size_t textLength = length - spot;
+    if (textLength >= sizeof(text)) textLength = sizeof(text) - 1;
+    memcpy(text, line + spot, textLength);
+    text[textLength] = '\0';
+
+    unsigned long id;
+    unsigned long localMillis;
+    if (sscanf(text, "!SYNC %lu %lu", &id, &localMillis) != 2) continue;
+
+    double localTime = localMillis;
+    if (source.hasTimestamp == true) localTime = source.time;
+    source.markers[id] = localTime;
+  }
+
+  //Back to the start for the merge
+  rewind(source.file);
+  source.start = 0;
+  source.used = 0;
+  source.endOfFile = false;
+  source.length = 0;
+  source.stored = 0;
+  source.time = 0;
+}
+
+//Fit time on the reference clock = slope * local time + offset using the markers both logs have
+static void fitClock(Source &source, const Source &reference)
+{
+  double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+  size_t matched = 0;
+
+  for (std::map<uint32_t, double>::const_iterator marker = source.markers.begin() ; marker != source.markers.end() ; marker++)
+  {
+    std::map<uint32_t, double>::const_iterator match = reference.markers.find(marker->first);
+    if (match == reference.markers.end()) continue;
+
+    double x = marker->second;
+    double y = match->second;
+    sumX += x;
+    sumY += y;
+    sumXX += x * x;
+    sumXY += x * y;
+    matched++;
+  }
+
+  if (matched == 0)
+  {
+    fprintf(stderr, "%s: no sync markers in common with %s, left as it is\n", source.name, reference.name);
+    return;
+  }
+
+  double meanX = sumX / matched;
+  double meanY = sumY / matched;
+  double variance = sumXX / matched - meanX * meanX;
+  source.slope = 1.0;
+  if (matched > 1 && variance > 0)
+    source.slope = (sumXY / matched - meanX * meanY) / variance;
+  source.offset = meanY - source.slope * meanX;
+
+  //Report how well the line fits
+  double worst = 0;
+  for (std::map<uint32_t, double>::const_iterator marker = source.markers.begin() ; marker != source.markers.end() ; marker++)
+  {
+    std::map<uint32_t, double>::const_iterator match = reference.markers.find(marker->first);
+    if (match == reference.markers.end()) continue;
+    double residual = fabs(source.slope * marker->second + source.offset - match->second);
+    if (residual > worst) worst = residual;
+  }
+
+  fprintf(stderr, "%s: %zu markers, offset %.1f ms, drift %.1f ppm, worst residual %.1f ms\n",
+          source.name, matched, source.offset, (source.slope - 1.0) * 1e6, worst);
+}
+
+static bool endsWith(const char *name, const char *ending)
+{
+  size_t nameLength = strlen(name);
+  size_t endingLength = strlen(ending);
+  return (nameLength >= endingLength && strcasecmp(name + nameLength - endingLength, ending) == 0);
+}
+
+int main(int argc, char **argv)
+{
+  bool label = false;
+  bool synchronize = false;
+  int firstFile = 1;
+  while (firstFile < argc && argv[firstFile][0] == '-')
+  {
+    if (strcmp(argv[firstFile], "-l") == 0) label = true;
+    else if (strcmp(argv[firstFile], "-s") == 0) synchronize = true;
+    else break;
+    firstFile++;
+  }
+
+  if (argc - firstFile < 1)
+  {
+    fprintf(stderr, "Usage: %s [-l] [-s] log1.txt log2.txt ... > merged.txt\n", argv[0]);
+    return (1);
+  }
+
+  std::vector<Source> sources(argc - firstFile);
+  std::priority_queue<Pending> heap;
+
+  for (size_t x = 0 ; x < sources.size() ; x++)
+  {
+    Source &source = sources[x];
+    source.name = argv[firstFile + x];
+    if (endsWith(source.name, "INDEX.TS"))
+    {
+      fprintf(stderr, "%s is a time-series index. Pass the partitions instead.\n", source.name);
+      return (1);
+    }
+
+    source.file = fopen(source.name, "rb");
+    if (source.file == NULL)
+    {
+      perror(source.name);
+      return (1);
+    }
+    source.binary = endsWith(source.name, ".TS");
+    source.block = (char *)malloc(blockSize);
+    source.start = 0;
+    source.used = 0;
+    source.endOfFile = false;
+    source.length = 0;
+    source.stored = 0;
+    source.time = 0;
+    source.hasTimestamp = false;
+    source.timeStart = 0;
+    source.timeEnd = 0;
+    source.slope = 1.0;
+    source.offset = 0.0;
+
+    if (synchronize == true && source.binary == false)
+      findMarkers(source);
+  }
+
+  if (synchronize == true)
+  {
+    for (size_t x = 1 ; x < sources.size() ; x++)
+      fitClock(sources[x], sources[0]);
+  }
+
+  for (size_t x = 0 ; x < sources.size() ; x++)
+  {
+    if (nextRecord(sources[x]) == true)
+    {
+      Pending pending = {sources[x].time, x};
+      heap.push(pending);
+    }
+  }
+
+  static char outputBuffer[1 << 20];
+  setvbuf(stdout, outputBuffer, _IOFBF, sizeof(outputBuffer));
+
+  while (heap.empty() == false)
+  {
+    size_t x = heap.top().source;
+    heap.pop();
+
+    Source &source = sources[x];
+    writeRecord(source, label, stdout);
+
+    //Keep taking from this log while it is still the earliest
+    while (nextRecord(source) == true)
+    {
+      if (heap.empty() == false &&
+          (heap.top().time < source.time || (heap.top().time == source.time && heap.top().source < x)))
+      {
+        Pending pending = {source.time, x};
+        heap.push(pending);
+        break;
+      }
+      writeRecord(source, label, stdout);
+    }
+  }
+
+  fflush(stdout);
+  for (size_t x = 0 ; x < sources.size() ; x++)
+  {
+    fclose(sources[x].file);
+    free(sources[x].block);
+  }
+  return (0);
+}
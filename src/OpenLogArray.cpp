@@ -0,0 +1,170 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Several Qwiic OpenLogs used together.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogArray.h"
+
+//Add an OpenLog that has already had begin() called
+boolean OpenLogArray::add(OpenLog &log)
+{
+  if (_count == QOL_ARRAY_MAX_LOGS) return (false);
+  _logs[_count++] = &log;
+  return (true);
+}
+
+uint8_t OpenLogArray::count()
+{
+  return (_count);
+}
+
+//Write the same bytes to every OpenLog
+//Returns the number of bytes written, or 0 if any OpenLog failed to take them
+//Like writeRaw(), bytes that would put an OpenLog into command mode are refused
+size_t OpenLogArray::write(const uint8_t *buffer, size_t size)
+{
+  if (_broadcast == true)
+  {
+    //Every OpenLog hears the broadcast so it has to be safe for all of them
+    for (uint8_t x = 0 ; x < _count ; x++)
+    {
+      if (_logs[x]->rawWriteAllowed(buffer, size) == false)
+        return (0);
+    }
+
+    //Anything an OpenLog is still holding has to land in its file ahead of the broadcast
+    flush();
+
+    //One transaction per chunk no matter how many OpenLogs are listening
+    for (size_t spot = 0 ; spot < size ; spot += I2C_BUFFER_LENGTH)
+    {
+      uint8_t toSend = I2C_BUFFER_LENGTH;
+      if (size - spot < toSend) toSend = size - spot;
+
+      _i2cPort->beginTransmission(QOL_GENERAL_CALL_ADDRESS);
+      _i2cPort->write(buffer + spot, toSend);
+      if (_i2cPort->endTransmission() != 0)
+        return (0); //Error: No one ack'd the general call
+      _broadcastBytes += toSend;
+
+      //Each OpenLog keeps its own checksum and sector position
+      for (uint8_t x = 0 ; x < _count ; x++)
+        _logs[x]->noteWritten(buffer + spot, toSend);
+    }
+    return (size);
+  }
+
+  size_t result = size;
+  for (uint8_t x = 0 ; x < _count ; x++)
+  {
+    if (_logs[x]->writeRaw(buffer, size) != size)
+      result = 0; //Keep going so the others still get the data
+  }
+  return (result);
+}
+
+size_t OpenLogArray::write(uint8_t character)
+{
+  return (write(&character, 1));
+}
+
+void OpenLogArray::flush()
+{
+  for (uint8_t x = 0 ; x < _count ; x++)
+    _logs[x]->flush();
+}
+
+boolean OpenLogArray::sync()
+{
+  boolean result = true;
+  for (uint8_t x = 0 ; x < _count ; x++)
+  {
+    if (_logs[x]->sync() == false)
+      result = false;
+  }
+  return (result);
+}
+
+boolean OpenLogArray::writeSyncMarker()
+{
+  return (writeSyncMarker(_nextMarker));
+}
+
+//The marker line is built once and then sent to each OpenLog back to back so the
+//markers land as close together in time as the bus allows. Mirrored bytes are sent raw so every
+//copy is the same. The millis() in the marker is the time it was sent.
+boolean OpenLogArray::writeSyncMarker(uint32_t id)
+{
+  String line = "!SYNC " + String(id) + " " + String(millis()) + "\r\n";
+  _nextMarker = id + 1;
+
+  return (write((const uint8_t *)line.c_str(), line.length()) > 0);
+}
+
+//Turn broadcast mirroring on or off
+//Every OpenLog has to report QOL_FEATURE_GENERAL_CALL, otherwise it wouldn't record what we send.
+//Anything each OpenLog is holding is sent first, then the size of each file is noted so
+//verifyMirrors() knows what to expect.
+boolean OpenLogArray::setBroadcast(boolean enable, TwoWire &wirePort)
+{
+  _broadcast = false;
+  flush();
+
+  if (enable == false) return (true);
+
+  for (uint8_t x = 0 ; x < _count ; x++)
+  {
+    if (_logs[x]->hasFeature(QOL_FEATURE_GENERAL_CALL) == false) return (false); //This OpenLog isn't listening
+
+    const String &fileName = _logs[x]->getCurrentFile();
+    if (fileName.length() == 0) return (false); //Can't check a log we can't name
+
+    _logs[x]->sync(); //So the size includes everything sent so far
+    int32_t fileSize = _logs[x]->size(fileName);
+    _startSizes[x] = (fileSize > 0) ? fileSize : 0; //-1 if the file doesn't exist yet
+  }
+
+  _i2cPort = &wirePort;
+  _broadcastBytes = 0;
+  _broadcast = true;
+  return (true);
+}
+
+//Check each OpenLog recorded everything that was broadcast
+//Each OpenLog is asked to sync and then for the size of its file. Costs two commands per OpenLog.
+//Returns a bit for each OpenLog (bit 0 for the first one added) whose file is short, 0 if all are good
+uint8_t OpenLogArray::verifyMirrors()
+{
+  uint8_t missing = 0;
+
+  for (uint8_t x = 0 ; x < _count ; x++)
+  {
+    const String &fileName = _logs[x]->getCurrentFile();
+    if (_broadcast == false || fileName.length() == 0)
+    {
+      missing |= 1 << x;
+      continue;
+    }
+
+    _logs[x]->sync();
+    int32_t fileSize = _logs[x]->size(fileName);
+    if (fileSize < 0 || (uint32_t)fileSize != _startSizes[x] + _broadcastBytes)
+      missing |= 1 << x;
+  }
+
+  return (missing);
+}
@@ -0,0 +1,73 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Several Qwiic OpenLogs used together.
+
+  Anything printed to the array is recorded, byte for byte, by every OpenLog in it. Each OpenLog's
+  line timestamps, sequence numbers, and CRCs are not added (see writeRaw()). writeSyncMarker() records a
+  "!SYNC <id> <millis>" line on every OpenLog in one pass. When the loggers are on different
+  microcontrollers, give each one the same marker IDs from a shared event (a GPS pulse, a trigger
+  line, a radio message) and extras/tools/qol_merge -s will work out the clock offset and drift of
+  each log from the markers.
+
+  Mirroring normally costs one I2C transaction per OpenLog for every chunk. In broadcast mode each
+  chunk is sent once to the I2C general call address (0x00) and every OpenLog that listens for general
+  calls records it. This needs OpenLog firmware with general call enabled, which it reports as
+  QOL_FEATURE_GENERAL_CALL. Each OpenLog is told what was broadcast so its own verification
+  (setVerification(), verifyFile()) and sector batching carry on as if it had sent the bytes itself.
+  verifyMirrors() checks afterwards that every OpenLog's file grew by what was sent.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+
+#define QOL_ARRAY_MAX_LOGS 8 //Every OpenLog needs its own I2C address
+#define QOL_GENERAL_CALL_ADDRESS 0x00
+
+class OpenLogArray : public Print {
+
+  public:
+    boolean add(OpenLog &log); //Returns false if the array is full
+    uint8_t count(); //Number of OpenLogs in the array
+
+    //Record the same bytes on every OpenLog
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    virtual size_t write(uint8_t character);
+    using Print::write;
+    virtual void flush();
+    boolean sync(); //Returns true if every OpenLog synced
+
+    //Record a "!SYNC <id> <millis>" line on every OpenLog. Returns true if every OpenLog took it.
+    boolean writeSyncMarker(); //Use the next marker ID
+    boolean writeSyncMarker(uint32_t id); //Use an ID shared with other loggers
+
+    //Send each chunk once to the general call address instead of once per OpenLog
+    //Every OpenLog must report QOL_FEATURE_GENERAL_CALL and have append()ed a file so it can be checked.
+    //Returns false if one doesn't.
+    boolean setBroadcast(boolean enable, TwoWire &wirePort = Wire);
+    uint8_t verifyMirrors(); //Sync, then check each file size. Returns a bit for each OpenLog that is missing data, 0 if all are good.
+
+  private:
+    OpenLog *_logs[QOL_ARRAY_MAX_LOGS];
+    uint8_t _count = 0;
+    uint32_t _nextMarker = 0;
+
+    boolean _broadcast = false;
+    TwoWire *_i2cPort = NULL;
+    uint32_t _startSizes[QOL_ARRAY_MAX_LOGS]; //Size of each file when broadcasting started
+    uint32_t _broadcastBytes = 0; //Bytes sent to the general call address since then
+};
@@ -0,0 +1,64 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Channel tagged records in a single shared log file.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogChannel.h"
+
+//Create a channel on a given OpenLog
+OpenLogChannel::OpenLogChannel(OpenLog &log, char id)
+{
+  _log = &log;
+  _record[0] = id;
+}
+
+//Add a character to the line. The line is sent when it ends or when the record is full.
+size_t OpenLogChannel::write(uint8_t character)
+{
+  _record[_recordLength++] = character;
+
+  if (character == '\n')
+    return (sendRecord(':') ? 1 : 0);
+
+  //Leave room for the new line that ends every record
+  if (_recordLength == QOL_CHANNEL_RECORD_LENGTH - 1)
+  {
+    _record[_recordLength++] = '\n';
+    return (sendRecord('+') ? 1 : 0);
+  }
+
+  return (1);
+}
+
+//Send whatever we have of the current line
+void OpenLogChannel::flush()
+{
+  if (_recordLength == 2) return; //Nothing waiting
+
+  _record[_recordLength++] = '\n';
+  sendRecord('+');
+}
+
+//Send the record as a single write so it can't be split up by another channel
+boolean OpenLogChannel::sendRecord(char separator)
+{
+  _record[1] = separator;
+  uint8_t recordLength = _recordLength;
+  _recordLength = 2;
+
+  return (_log->writeRaw(_record, recordLength) == recordLength);
+}
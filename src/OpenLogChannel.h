@@ -0,0 +1,49 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Lets several parts of a sketch share one log file without sending append commands.
+
+  Each channel collects a line and sends it as one record tagged with the channel's ID:
+    <id>:<line>\n   a complete line
+    <id>+<part>\n   part of a line that was too long for one record. The line continues in the next record.
+  Records are sized to fit in a single I2C transaction and are sent as is (see writeRaw()).
+
+  extras/tools/qol_demux.cpp splits a multiplexed log back into one file per channel.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+
+#define QOL_CHANNEL_RECORD_LENGTH I2C_BUFFER_LENGTH //ID, separator, data, and new line fit in one transaction
+
+class OpenLogChannel : public Print {
+
+  public:
+    //The ID is a single printable character such as 'G' for GPS or '1' for sensor 1
+    OpenLogChannel(OpenLog &log, char id);
+
+    virtual size_t write(uint8_t character);
+    using Print::write;
+    virtual void flush(); //Send a partial line now. It is marked as continuing.
+
+  private:
+    boolean sendRecord(char separator);
+
+    OpenLog *_log;
+    uint8_t _record[QOL_CHANNEL_RECORD_LENGTH]; //Starts with the ID and separator
+    uint8_t _recordLength = 2;
+};
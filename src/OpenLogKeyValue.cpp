@@ -0,0 +1,495 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  A small append-only key/value store built on append, read, and remove.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogKeyValue.h"
+
+//Find the store on the card (or start a new one) and build the index
+//Call append() on your log file before this so we know where to return to after each change.
+//Returns false if no file has been append()ed, or if either file holds something that isn't a store.
+//Files that hold anything else are left alone so a typo in a file name can't remove someone's data.
+boolean OpenLogKeyValue::begin(OpenLog &log, String fileNameA, String fileNameB)
+{
+  _log = &log;
+  _fileNames[0] = fileNameA;
+  _fileNames[1] = fileNameB;
+
+  _count = 0;
+  _liveBytes = 0;
+  _needsNewline = false;
+  for (uint8_t x = 0 ; x < QOL_KV_MAX_KEYS ; x++)
+    _entries[x].key[0] = '\0';
+
+  if (_log->getCurrentFile().length() == 0) return (false); //We'd have no way back to the user's log
+
+  int32_t generationA = readGeneration(0);
+  int32_t generationB = readGeneration(1);
+  if (generationA == QOL_KV_NOT_A_STORE || generationB == QOL_KV_NOT_A_STORE) return (false);
+
+  if (generationA == QOL_KV_NO_HEADER && generationB == QOL_KV_NO_HEADER)
+  {
+    //No store yet. Clear out anything left from a failed start and begin a new file.
+    //Both files are missing or hold only part of a header so there is nothing to lose.
+    _log->removeFile(_fileNames[0]);
+    _log->removeFile(_fileNames[1]);
+
+    _previousFile = _log->getCurrentFile();
+    uint8_t header = startFile(0, 0);
+    boolean result = (header > 0 && _log->sync());
+    restoreFile();
+
+    _active = 0;
+    _generation = 0;
+    _fileSize = header;
+    return (result);
+  }
+
+  if (generationA >= 0 && generationB >= 0)
+  {
+    //Compaction was interrupted. The older file was never removed so it is still complete.
+    if ((int16_t)(generationB - generationA) > 0)
+      _active = 0;
+    else
+      _active = 1;
+  }
+  else if (generationA >= 0)
+    _active = 0;
+  else
+    _active = 1;
+
+  _log->removeFile(_fileNames[1 - _active]); //Remove the partial file
+  _generation = (_active == 0) ? generationA : generationB;
+
+  return (loadFile());
+}
+
+//Record a value for a given key
+//Keys can be up to QOL_KV_KEY_LENGTH characters and can't contain '=', '!' or new lines
+//Values can be up to QOL_KV_VALUE_LENGTH characters and can't contain new lines
+boolean OpenLogKeyValue::put(const char *key, const char *value)
+{
+  uint8_t keyLength = strlen(key);
+  size_t valueLength = strlen(value);
+  if (keyLength == 0 || keyLength > QOL_KV_KEY_LENGTH || valueLength > QOL_KV_VALUE_LENGTH) return (false);
+  if (strpbrk(key, "=!\r\n") != NULL || strpbrk(value, "\r\n") != NULL) return (false);
+
+  //Make sure there is room in the index before we write anything
+  int8_t slot = findSlot(key);
+  if (_entries[slot].key[0] == '\0' && _count >= QOL_KV_MAX_KEYS - 1) return (false);
+
+  uint32_t recordStart;
+  if (appendRecord(key, '=', value, valueLength, recordStart) == false)
+    return (false);
+
+  setEntry(key, recordStart + keyLength + 1, valueLength);
+
+  checkCompaction();
+  return (true);
+}
+
+//Copy the value for a key into the given buffer
+//Returns the length of the value or -1 if the key is not in the store
+//This costs a single read command
+int16_t OpenLogKeyValue::get(const char *key, char *value, uint8_t valueSize)
+{
+  if (valueSize == 0) return (-1);
+
+  int8_t slot = findSlot(key);
+  if (_entries[slot].key[0] == '\0') return (-1); //Key not found
+
+  uint8_t length = _entries[slot].length;
+  if (length > valueSize - 1) length = valueSize - 1; //Go smaller if that's all the room we have
+
+  if (length > 0)
+    _log->read((uint8_t *)value, length, _fileNames[_active], _entries[slot].offset);
+  value[length] = '\0';
+
+  return (_entries[slot].length);
+}
+
+//Forget a key
+//Returns false if the key was not in the store
+boolean OpenLogKeyValue::remove(const char *key)
+{
+  int8_t slot = findSlot(key);
+  if (_entries[slot].key[0] == '\0') return (false); //Key not found
+
+  uint32_t recordStart;
+  if (appendRecord(key, '!', "", 0, recordStart) == false)
+    return (false);
+
+  _liveBytes -= strlen(key) + _entries[slot].length + 2;
+  removeSlot(slot);
+  _count--;
+
+  checkCompaction();
+  return (true);
+}
+
+//Copy the live values into the other file and remove the old one
+//The old file stays complete until the new one has been synced
+boolean OpenLogKeyValue::compact()
+{
+  uint8_t newFile = 1 - _active;
+  uint16_t newGeneration = _generation + 1;
+  uint32_t newOffsets[QOL_KV_MAX_KEYS];
+
+  _previousFile = _log->getCurrentFile();
+
+  uint32_t newSize = startFile(newFile, newGeneration);
+  boolean result = (newSize > 0);
+
+  for (uint8_t slot = 0 ; slot < QOL_KV_MAX_KEYS && result == true ; slot++)
+  {
+    if (_entries[slot].key[0] == '\0') continue;
+
+    //Build the record in place: key=value\n
+    char record[QOL_KV_KEY_LENGTH + QOL_KV_VALUE_LENGTH + 2];
+    uint8_t keyLength = strlen(_entries[slot].key);
+    uint8_t length = _entries[slot].length;
+
+    memcpy(record, _entries[slot].key, keyLength);
+    record[keyLength] = '=';
+    if (length > 0)
+      _log->read((uint8_t *)&record[keyLength + 1], length, _fileNames[_active], _entries[slot].offset);
+    record[keyLength + 1 + length] = '\n';
+
+    uint8_t recordLength = keyLength + length + 2;
+    if (_log->writeRaw((uint8_t *)record, recordLength) != recordLength)
+      result = false;
+
+    newOffsets[slot] = newSize + keyLength + 1;
+    newSize += recordLength;
+  }
+
+  if (result == true)
+    result = _log->sync();
+
+  if (result == false)
+  {
+    restoreFile();
+    _log->removeFile(_fileNames[newFile]); //The old file is still good
+    return (false);
+  }
+
+  _log->removeFile(_fileNames[_active]);
+  restoreFile();
+
+  for (uint8_t slot = 0 ; slot < QOL_KV_MAX_KEYS ; slot++)
+    _entries[slot].offset = newOffsets[slot];
+
+  _active = newFile;
+  _generation = newGeneration;
+  _fileSize = newSize;
+  _needsNewline = false;
+
+  return (true);
+}
+
+//Returns the number of keys in the store
+uint8_t OpenLogKeyValue::count()
+{
+  return (_count);
+}
+
+//Returns the number of bytes in the file used by values that have been replaced or removed
+uint32_t OpenLogKeyValue::garbageBytes()
+{
+  return (_fileSize - headerLength(_generation) - _liveBytes);
+}
+
+//Add a key to the index, or update where its value lives
+boolean OpenLogKeyValue::setEntry(const char *key, uint32_t offset, uint8_t length)
+{
+  int8_t slot = findSlot(key);
+  uint8_t keyLength = strlen(key);
+
+  if (_entries[slot].key[0] == '\0')
+  {
+    if (_count >= QOL_KV_MAX_KEYS - 1) return (false); //Index is full. Keep one slot empty so searches end.
+    strcpy(_entries[slot].key, key);
+    _count++;
+  }
+  else
+    _liveBytes -= keyLength + _entries[slot].length + 2; //The old record is now garbage
+
+  _entries[slot].offset = offset;
+  _entries[slot].length = length;
+  _liveBytes += keyLength + length + 2;
+
+  return (true);
+}
+
+//Linear probe from the key's hash until we find the key or an empty slot
+int8_t OpenLogKeyValue::findSlot(const char *key)
+{
+  uint8_t slot = hash(key) % QOL_KV_MAX_KEYS;
+
+  while (_entries[slot].key[0] != '\0' && strcmp(_entries[slot].key, key) != 0)
+    slot = (slot + 1) % QOL_KV_MAX_KEYS;
+
+  return (slot);
+}
+
+//Empty a slot and move any following entries back so they can still be found
+void OpenLogKeyValue::removeSlot(int8_t slot)
+{
+  uint8_t hole = slot;
+  uint8_t next = slot;
+
+  _entries[hole].key[0] = '\0';
+
+  while (true)
+  {
+    next = (next + 1) % QOL_KV_MAX_KEYS;
+    if (_entries[next].key[0] == '\0') break;
+
+    //Move the entry back if its home slot is not between the hole and where it sits now
+    uint8_t home = hash(_entries[next].key) % QOL_KV_MAX_KEYS;
+    boolean inRange;
+    if (hole <= next)
+      inRange = (home > hole && home <= next);
+    else
+      inRange = (home > hole || home <= next);
+
+    if (inRange == false)
+    {
+      _entries[hole] = _entries[next];
+      _entries[next].key[0] = '\0';
+      hole = next;
+    }
+  }
+}
+
+//FNV-1a hash of the key
+uint8_t OpenLogKeyValue::hash(const char *key)
+{
+  uint16_t hash = 0x811C;
+  while (*key)
+  {
+    hash ^= (uint8_t)*key++;
+    hash *= 0x0193;
+  }
+  return (hash ^ (hash >> 8));
+}
+
+//Read the active file and build the index
+//The file is read in small windows. Each record is a line.
+boolean OpenLogKeyValue::loadFile()
+{
+  int32_t fileSize = _log->size(_fileNames[_active]);
+  if (fileSize < 0) return (false);
+  _fileSize = fileSize;
+
+  uint8_t window[64];
+  uint32_t offset = headerLength(_generation);
+  boolean skipping = false; //True while we pass over a line that is too long to be one of ours
+
+  while (offset < _fileSize)
+  {
+    uint16_t toRead = sizeof(window);
+    if (_fileSize - offset < toRead) toRead = _fileSize - offset;
+
+    _log->read(window, toRead, _fileNames[_active], offset);
+
+    uint8_t lineStart = 0;
+    for (uint8_t x = 0 ; x < toRead ; x++)
+    {
+      if (window[x] != '\n') continue;
+
+      if (skipping == false)
+        parseRecord(&window[lineStart], x - lineStart, offset + lineStart);
+      skipping = false;
+      lineStart = x + 1;
+    }
+
+    if (lineStart == 0)
+    {
+      if (toRead < sizeof(window))
+      {
+        _needsNewline = true; //Power was lost part way through a record
+        break;
+      }
+      skipping = true;
+      lineStart = toRead;
+    }
+    else if (lineStart < toRead && offset + toRead == _fileSize)
+    {
+      _needsNewline = true;
+      break;
+    }
+
+    offset += lineStart;
+  }
+
+  return (true);
+}
+
+//Add a "key=value" or "key!" line to the index
+void OpenLogKeyValue::parseRecord(const uint8_t *line, uint8_t length, uint32_t lineOffset)
+{
+  char key[QOL_KV_KEY_LENGTH + 1];
+
+  for (uint8_t x = 0 ; x < length && x <= QOL_KV_KEY_LENGTH ; x++)
+  {
+    if (line[x] == '=' && x > 0)
+    {
+      key[x] = '\0';
+      uint8_t valueLength = length - x - 1;
+      if (valueLength <= QOL_KV_VALUE_LENGTH)
+        setEntry(key, lineOffset + x + 1, valueLength);
+      return;
+    }
+    if (line[x] == '!' && x > 0)
+    {
+      key[x] = '\0';
+      int8_t slot = findSlot(key);
+      if (_entries[slot].key[0] != '\0')
+      {
+        _liveBytes -= x + _entries[slot].length + 2;
+        removeSlot(slot);
+        _count--;
+      }
+      return;
+    }
+    if (x < QOL_KV_KEY_LENGTH) key[x] = line[x];
+  }
+  //Not a record we understand. It's counted as garbage.
+}
+
+//Start a new file with a "#KV <generation>" line
+//Leaves OpenLog appending to the new file
+//Returns the length of the header or 0 if something went wrong
+uint8_t OpenLogKeyValue::startFile(uint8_t fileNumber, uint16_t generation)
+{
+  if (_log->append(_fileNames[fileNumber]) == false)
+    return (0);
+
+  String header = "#KV " + String(generation) + "\n";
+  if (_log->writeRaw((const uint8_t *)header.c_str(), header.length()) != header.length())
+    return (0);
+
+  return (header.length());
+}
+
+//Read the "#KV <generation>" line at the start of a file
+//Returns QOL_KV_NO_HEADER if the file is missing or power was lost part way through the header,
+//or QOL_KV_NOT_A_STORE if the file holds something else
+int32_t OpenLogKeyValue::readGeneration(uint8_t fileNumber)
+{
+  int32_t fileSize = _log->size(_fileNames[fileNumber]);
+  if (fileSize <= 0) return (QOL_KV_NO_HEADER); //Missing, or created and nothing written
+
+  uint8_t header[10];
+  uint8_t toRead = sizeof(header);
+  if (fileSize < toRead) toRead = fileSize;
+  _log->read(header, toRead, _fileNames[fileNumber]);
+
+  int32_t generation = 0;
+  for (uint8_t x = 0 ; x < toRead ; x++)
+  {
+    if (x < 4)
+    {
+      if (header[x] != "#KV "[x]) return (QOL_KV_NOT_A_STORE);
+      continue;
+    }
+    if (header[x] == '\n')
+    {
+      if (x == 4 || generation > 0xFFFF) return (QOL_KV_NOT_A_STORE);
+      return (generation);
+    }
+    if (header[x] < '0' || header[x] > '9') return (QOL_KV_NOT_A_STORE);
+    generation = generation * 10 + (header[x] - '0');
+  }
+
+  //Everything we read looks like a header that was never finished
+  if (toRead == fileSize) return (QOL_KV_NO_HEADER);
+  return (QOL_KV_NOT_A_STORE); //Too many digits to be ours
+}
+
+//Number of bytes in the "#KV <generation>\n" line
+uint8_t OpenLogKeyValue::headerLength(uint16_t generation)
+{
+  return (String(generation).length() + 5);
+}
+
+//Append one record to the active file and sync it to the card
+//recordStart is set to where the record begins in the file
+boolean OpenLogKeyValue::appendRecord(const char *key, char separator, const char *value, uint8_t valueLength, uint32_t &recordStart)
+{
+  char record[QOL_KV_KEY_LENGTH + QOL_KV_VALUE_LENGTH + 3];
+  uint8_t recordLength = 0;
+
+  if (_needsNewline == true)
+    record[recordLength++] = '\n'; //End the partial line left by a power loss
+
+  uint8_t keyLength = strlen(key);
+  memcpy(&record[recordLength], key, keyLength);
+  recordLength += keyLength;
+  record[recordLength++] = separator;
+  memcpy(&record[recordLength], value, valueLength);
+  recordLength += valueLength;
+  record[recordLength++] = '\n';
+
+  if (openFile() == false)
+    return (false);
+
+  boolean result = (_log->writeRaw((uint8_t *)record, recordLength) == recordLength);
+  if (result == true)
+    result = _log->sync(); //Make sure the record is on the card before we report success
+
+  restoreFile();
+
+  if (result == false)
+    return (false);
+
+  recordStart = _fileSize;
+  if (_needsNewline == true)
+  {
+    recordStart++; //Skip the new line we added
+    _needsNewline = false;
+  }
+  _fileSize += recordLength;
+  return (true);
+}
+
+//Compact once old values take up more of the file than live ones
+void OpenLogKeyValue::checkCompaction()
+{
+  uint32_t garbage = garbageBytes();
+  if (garbage > QOL_KV_COMPACT_THRESHOLD && garbage > _liveBytes)
+    compact();
+}
+
+//Point OpenLog at our file, remembering what the user was logging to
+boolean OpenLogKeyValue::openFile()
+{
+  _previousFile = _log->getCurrentFile();
+  if (_previousFile == _fileNames[_active]) return (true);
+
+  return (_log->append(_fileNames[_active]));
+}
+
+//Point OpenLog back at the user's log
+void OpenLogKeyValue::restoreFile()
+{
+  if (_previousFile.length() == 0) return; //User was logging to OpenLog's default log. We have no name to go back to.
+  if (_previousFile == _log->getCurrentFile()) return;
+
+  _log->append(_previousFile);
+}
@@ -0,0 +1,97 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  A small key/value store for things like calibration values and counters.
+
+  Every change is appended to a log file as a "key=value" line and an index of key -> offset
+  is kept in RAM so that looking up a value is a single read command. When enough of the file
+  is made up of old values the live values are copied into a second file and the first is removed.
+
+  Records are written with writeRaw() so the log's line timestamps and CRCs never end up in them.
+
+  The files start with a "#KV <generation>" line. If power is lost during compaction both files
+  will exist and the older (lower generation) file is still complete so we keep it. A file that
+  holds anything other than a store is never removed; begin() returns false instead.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+
+//Size of the RAM index. Each entry takes QOL_KV_KEY_LENGTH + 6 bytes. One slot is always kept empty.
+#define QOL_KV_MAX_KEYS 16
+
+#define QOL_KV_KEY_LENGTH 12 //Longest key we can store
+#define QOL_KV_VALUE_LENGTH 32 //Longest value we can store
+
+//What readGeneration() returns when it can't find a generation
+#define QOL_KV_NO_HEADER -1 //Missing, empty, or only part of a header
+#define QOL_KV_NOT_A_STORE -2 //Holds something else
+
+//Compact once the file has this many bytes of old values (and more old bytes than live bytes)
+#define QOL_KV_COMPACT_THRESHOLD 1024
+
+class OpenLogKeyValue {
+
+  public:
+    //The store alternates between two files. Use 8.3 names such as "CONFIG0.KV" and "CONFIG1.KV"
+    //Call append() on your own log first. OpenLog is pointed back at it after every change.
+    boolean begin(OpenLog &log, String fileNameA, String fileNameB);
+
+    boolean put(const char *key, const char *value); //Record a value. The value is on the card when this returns.
+    int16_t get(const char *key, char *value, uint8_t valueSize); //Returns the length of the value or -1 if key is not found
+    boolean remove(const char *key); //Forget a key
+    boolean compact(); //Copy the live values into a fresh file
+
+    uint8_t count(); //Number of keys in the store
+    uint32_t garbageBytes(); //Number of bytes in the file taken up by old values
+
+  private:
+    struct Entry
+    {
+      char key[QOL_KV_KEY_LENGTH + 1]; //Empty string marks an empty slot
+      uint32_t offset; //Where the value starts in the file
+      uint8_t length; //Length of the value
+    };
+
+    int8_t findSlot(const char *key); //Returns the slot holding this key or the empty slot where it would go
+    void removeSlot(int8_t slot);
+    uint8_t hash(const char *key);
+
+    boolean setEntry(const char *key, uint32_t offset, uint8_t length); //Add or update a key in the index
+    void parseRecord(const uint8_t *line, uint8_t length, uint32_t lineOffset);
+
+    boolean loadFile(); //Read the file and build the index
+    uint8_t startFile(uint8_t fileNumber, uint16_t generation); //Write the header to a new file. Returns the header length or 0.
+    int32_t readGeneration(uint8_t fileNumber); //Returns the generation in the header, QOL_KV_NO_HEADER, or QOL_KV_NOT_A_STORE
+    uint8_t headerLength(uint16_t generation);
+    boolean appendRecord(const char *key, char separator, const char *value, uint8_t valueLength, uint32_t &recordStart);
+    void checkCompaction();
+    boolean openFile(); //Point OpenLog at our file
+    void restoreFile(); //Point OpenLog back at whatever the user was logging to
+
+    OpenLog *_log;
+    String _fileNames[2];
+    uint8_t _active = 0; //Which of the two files holds the store
+    uint16_t _generation = 0;
+    uint32_t _fileSize = 0; //Tracked locally so we never need to ask OpenLog
+    uint32_t _liveBytes = 0; //Bytes of the file holding current records
+    boolean _needsNewline = false; //A partial line was left at the end of the file by a power loss
+    String _previousFile; //The file the user was appending to before we took over
+
+    Entry _entries[QOL_KV_MAX_KEYS];
+    uint8_t _count = 0;
+};
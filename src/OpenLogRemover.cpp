@@ -0,0 +1,176 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Removes a directory and everything in it a few files at a time.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogRemover.h"
+
+void OpenLogRemover::begin(OpenLog &log, String directoryName)
+{
+  _log = &log;
+  _path = directoryName;
+  _depth = 1;
+  _removedCount = 0;
+  _done = false;
+  _error = false;
+}
+
+//Do batches until we run out of time or the directory is gone
+boolean OpenLogRemover::service(uint16_t timeBudget)
+{
+  uint32_t startTime = millis();
+
+  while (_done == false)
+  {
+    if (doBatch() == false)
+    {
+      _error = true;
+      _done = true;
+    }
+
+    if (millis() - startTime >= timeBudget) break;
+  }
+
+  return (_done == false);
+}
+
+//Remove up to QOL_REMOVER_BATCH files from the directory we're working on
+//If the directory holds a subdirectory we move down into it. If the directory is empty we remove
+//it and move back up to its parent.
+boolean OpenLogRemover::doBatch()
+{
+  if (enterPath() == false)
+    return (false);
+
+  OpenLogListCursor cursor;
+  OpenLogName names[QOL_REMOVER_BATCH];
+  _log->startListing(cursor, "*");
+  uint8_t count = _log->listPage(cursor, names, QOL_REMOVER_BATCH);
+  char *subdirectory = NULL;
+
+  for (uint8_t x = 0 ; x < count ; x++)
+  {
+    uint8_t length = strlen(names[x]);
+    if (names[x][length - 1] == '/')
+    {
+      names[x][length - 1] = '\0';
+      subdirectory = names[x];
+      break;
+    }
+
+    if (_log->removeFile(names[x]) <= 0)
+    {
+      //We'd list the same file again next time and never finish
+      leavePath();
+      return (false);
+    }
+    _removedCount++;
+  }
+
+  //Go back up the path we came down before making it any longer
+  leavePath();
+
+  if (subdirectory != NULL)
+  {
+    //Work on the subdirectory next
+    _path += "/";
+    _path += subdirectory;
+    _depth++;
+  }
+
+  if (count > 0)
+    return (true);
+
+  //The directory is empty. Remove it from its parent.
+  int16_t slash = _path.lastIndexOf('/');
+  String directoryName = _path.substring(slash + 1);
+  _path.remove(slash < 0 ? 0 : slash);
+  _depth--;
+
+  if (enterPath() == false)
+    return (false);
+  boolean result = (_log->removeDirectory(directoryName) > 0);
+  leavePath();
+
+  if (result == true)
+    _removedCount++;
+  if (_depth == 0)
+    _done = true;
+  return (result);
+}
+
+//Change down through each directory in _path
+boolean OpenLogRemover::enterPath()
+{
+  uint8_t entered = 0;
+  int16_t start = 0;
+
+  while (entered < _depth)
+  {
+    int16_t slash = _path.indexOf('/', start);
+    String directoryName = (slash < 0) ? _path.substring(start) : _path.substring(start, slash);
+
+    if (changeDown(directoryName) == false)
+    {
+      //Go back up whatever we did manage
+      while (entered-- > 0)
+        _log->changeDirectory("..");
+      return (false);
+    }
+    entered++;
+    start = slash + 1;
+  }
+  return (true);
+}
+
+//Change into a directory and make sure it worked
+//If the cd had failed we would be listing (and removing) the wrong directory
+boolean OpenLogRemover::changeDown(String directoryName)
+{
+  if (_log->changeDirectory(directoryName) == false)
+    return (false);
+
+  uint8_t status = _log->getStatus();
+  return ((status & 1<<STATUS_LAST_COMMAND_KNOWN) && (status & 1<<STATUS_LAST_COMMAND_SUCCESS));
+}
+
+void OpenLogRemover::leavePath()
+{
+  for (uint8_t x = 0 ; x < _depth ; x++)
+    _log->changeDirectory("..");
+}
+
+boolean OpenLogRemover::isDone()
+{
+  return (_done);
+}
+
+boolean OpenLogRemover::hadError()
+{
+  return (_error);
+}
+
+//Return the number of files and directories removed so far
+uint32_t OpenLogRemover::getRemovedCount()
+{
+  return (_removedCount);
+}
+
+const String &OpenLogRemover::getCurrentDirectory()
+{
+  return (_path);
+}
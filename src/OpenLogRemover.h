@@ -0,0 +1,61 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Removes a directory and everything in it a few files at a time.
+
+  removeDirectory() sends "rm -rf" and waits until OpenLog has removed everything, which for a
+  directory of thousands of files can take a long time. The remover instead walks the tree from
+  service(), removing a small batch of files each time, so logging carries on in between.
+
+  Each batch changes down into the directory being worked on, lists the first few entries, removes
+  the files (or goes down into the first subdirectory), then changes back up to where it started.
+  Once a directory is empty it is removed and the walk carries on in its parent.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+
+#define QOL_REMOVER_BATCH 4 //Entries listed and removed per batch
+
+class OpenLogRemover {
+
+  public:
+    //Start removing a directory in the current directory. Nothing is removed until service() is called.
+    void begin(OpenLog &log, String directoryName);
+
+    //Remove batches until timeBudget milliseconds have been used. At least one batch is done per call.
+    //Returns true if there is more to remove
+    boolean service(uint16_t timeBudget);
+
+    boolean isDone(); //True once the directory is gone (or we hit an error)
+    boolean hadError(); //True if OpenLog refused a command. The walk stops.
+    uint32_t getRemovedCount(); //Files and directories removed so far
+    const String &getCurrentDirectory(); //The directory being worked on, such as "LOGS/MONDAY"
+
+  private:
+    boolean doBatch(); //Returns false on an error
+    boolean enterPath(); //Change down into _path. Returns false on an error.
+    boolean changeDown(String directoryName); //cd and check OpenLog says it worked
+    void leavePath(); //Change back up to where we started
+
+    OpenLog *_log;
+    String _path; //Directories from where we started down to the one being worked on, separated by /
+    uint8_t _depth = 0; //Number of directories in _path
+    uint32_t _removedCount = 0;
+    boolean _done = true;
+    boolean _error = false;
+};
@@ -0,0 +1,326 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Age and size based cleanup of old logs, spread out over time.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogRetention.h"
+
+//Store which OpenLog to use and how to read dates from names
+void OpenLogRetention::begin(OpenLog &log, int32_t (*dateFromName)(const char *name))
+{
+  _log = &log;
+  _dateFromName = dateFromName;
+  if (_dateFromName == NULL) _dateFromName = dateFromYYMMDD;
+
+  _entryCount = 0;
+  _totalKilobytes = 0;
+  _overflow = false;
+}
+
+//List the current directory and build the index of dated logs
+//Everything that matches the pattern is sized, including what is inside directories, so the size
+//limit sees the whole directory even when there are more dated logs than the index can hold
+//Returns the number of dated logs in the index
+uint8_t OpenLogRetention::inventory(String pattern)
+{
+  _entryCount = 0;
+  _overflow = false;
+  _removingDirectory = false; //A directory we were part way through will be found again
+
+  _totalKilobytes = listKilobytes(pattern.c_str());
+
+  return (_entryCount);
+}
+
+//Set today's day number. Logs are aged against this.
+void OpenLogRetention::setToday(uint16_t today)
+{
+  _today = today;
+}
+
+//Remove logs more than this many days old
+void OpenLogRetention::setMaxAge(uint16_t days)
+{
+  _maxAge = days;
+}
+
+//Remove the oldest logs until the dated logs take up less than this
+void OpenLogRetention::setMaxKilobytes(uint32_t kilobytes)
+{
+  _maxKilobytes = kilobytes;
+}
+
+//Remove logs that break the policy, oldest first, until we run out of time
+//Call this from loop(). Each call removes at least one file, or one batch from a directory, if
+//there is something to remove. A directory is removed over as many calls as it takes.
+boolean OpenLogRetention::service(uint16_t timeBudget)
+{
+  uint32_t startTime = millis();
+
+  while (_entryCount > 0 && (_removingDirectory == true || expired(_entries[0]) == true))
+  {
+    boolean removed;
+    uint8_t length = strlen(_entries[0].name);
+
+    if (_removingDirectory == false && _entries[0].name[length - 1] == '/')
+    {
+      _entries[0].name[length - 1] = '\0'; //The remover wants the directory name without the slash
+      _remover.begin(*_log, _entries[0].name);
+      _removingDirectory = true;
+    }
+
+    if (_removingDirectory == true)
+    {
+      uint32_t used = millis() - startTime;
+      _remover.service(used < timeBudget ? timeBudget - used : 0);
+      if (_remover.isDone() == false) break; //Carry on next time
+
+      _removingDirectory = false;
+      removed = (_remover.hadError() == false);
+    }
+    else
+      removed = (_log->removeFile(_entries[0].name) > 0);
+
+    //If OpenLog couldn't remove it we still move on so one stuck log can't stop the rest
+    if (removed == true)
+    {
+      _totalKilobytes -= _entries[0].kilobytes;
+      _removedCount++;
+    }
+
+    //Drop the oldest entry
+    _entryCount--;
+    memmove(&_entries[0], &_entries[1], _entryCount * sizeof(Entry));
+
+    if (millis() - startTime >= timeBudget) break;
+  }
+
+  return (_removingDirectory == true || (_entryCount > 0 && expired(_entries[0]) == true));
+}
+
+//Return the number of dated logs in the index
+uint8_t OpenLogRetention::getEntryCount()
+{
+  return (_entryCount);
+}
+
+//Return the size of everything inventory() found, less any logs we've removed
+uint32_t OpenLogRetention::getTotalKilobytes()
+{
+  return (_totalKilobytes);
+}
+
+//Return the number of logs removed
+uint32_t OpenLogRetention::getRemovedCount()
+{
+  return (_removedCount);
+}
+
+//The index only holds the oldest QOL_RETENTION_MAX_ENTRIES logs
+//Once those are removed, call inventory() again to pick up the rest
+boolean OpenLogRetention::needsInventory()
+{
+  return (_overflow == true && _entryCount == 0);
+}
+
+//Convert a date to the number of days since January 1st, 2000
+uint16_t OpenLogRetention::dayNumber(uint16_t year, uint8_t month, uint8_t day)
+{
+  const uint16_t daysBeforeMonth[] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+  if (year >= 2000) year -= 2000;
+  if (month < 1 || month > 12) month = 1;
+
+  uint16_t days = year * 365 + (year + 3) / 4; //2000 was a leap year
+  days += daysBeforeMonth[month - 1];
+  if (month > 2 && year % 4 == 0) days++;
+  days += day - 1;
+
+  return (days);
+}
+
+//Find the first six digits in a row in the name and read them as YYMMDD
+//Returns -1 if there is no valid date
+int32_t OpenLogRetention::dateFromYYMMDD(const char *name)
+{
+  uint8_t digits = 0;
+
+  for (uint8_t x = 0 ; name[x] != '\0' ; x++)
+  {
+    if (name[x] >= '0' && name[x] <= '9')
+    {
+      digits++;
+      if (digits == 6)
+      {
+        const char *date = &name[x - 5];
+        uint8_t year = (date[0] - '0') * 10 + (date[1] - '0');
+        uint8_t month = (date[2] - '0') * 10 + (date[3] - '0');
+        uint8_t day = (date[4] - '0') * 10 + (date[5] - '0');
+
+        if (month < 1 || month > 12 || day < 1 || day > 31) return (-1);
+        return (dayNumber(year, month, day));
+      }
+    }
+    else
+      digits = 0;
+  }
+
+  return (-1);
+}
+
+//Insert a log into the index, keeping it sorted oldest first
+//If the index is full the newest log is dropped. It will be found on the next inventory.
+boolean OpenLogRetention::addEntry(const char *name, uint16_t day, uint32_t kilobytes)
+{
+  uint8_t spot = _entryCount;
+  while (spot > 0 && _entries[spot - 1].day > day) spot--;
+
+  if (_entryCount == QOL_RETENTION_MAX_ENTRIES)
+  {
+    _overflow = true;
+    if (spot == QOL_RETENTION_MAX_ENTRIES) return (false); //Newer than everything we have
+    _entryCount--; //Drop the newest
+  }
+
+  memmove(&_entries[spot + 1], &_entries[spot], (_entryCount - spot) * sizeof(Entry));
+  strcpy(_entries[spot].name, name);
+  _entries[spot].day = day;
+  _entries[spot].kilobytes = kilobytes;
+  _entryCount++;
+
+  return (true);
+}
+
+//Returns true if this log is too old, or we are over our size and this is the oldest log
+boolean OpenLogRetention::expired(const Entry &entry)
+{
+  if (_maxAge > 0 && _today > _maxAge && entry.day < _today - _maxAge) return (true);
+  if (_maxKilobytes > 0 && _totalKilobytes > _maxKilobytes) return (true);
+  return (false);
+}
+
+//List the current directory a page at a time and add up the size of everything in it
+//Files are sized a page at a time with one batch. Directories are gone into and sized the same way
+//down to QOL_RETENTION_MAX_DEPTH. At the top level dated logs are added to the index as we go.
+//The walk doesn't recurse: one set of page buffers is shared by every level, and each level only
+//keeps the name and position of the directory we went into so its listing can be picked up after it.
+//Sizing and changing directory interrupt the listing. Picking it up again costs one read on firmware
+//with QOL_FEATURE_LS_SKIP. Older firmware reads the names ahead of the page again.
+uint32_t OpenLogRetention::listKilobytes(const char *pattern)
+{
+  struct Level
+  {
+    OpenLogName directory; //The directory we went into, with its trailing /
+    uint16_t position; //Where it was in its parent's listing
+    uint32_t totalBefore; //The total when we went into it
+  };
+  Level levels[QOL_RETENTION_MAX_DEPTH];
+  uint8_t depth = 0;
+
+  OpenLogListCursor cursor;
+  OpenLogName names[QOL_RETENTION_PAGE];
+  const char *fileNames[QOL_RETENTION_PAGE];
+  int32_t fileSizes[QOL_RETENTION_PAGE];
+  uint32_t total = 0;
+
+  _log->startListing(cursor, pattern);
+
+  while (true)
+  {
+    uint8_t count = _log->listPage(cursor, names, QOL_RETENTION_PAGE);
+    uint16_t pageStart = cursor.position - count; //Position of names[0] in the listing
+
+    if (count == 0)
+    {
+      if (depth == 0) break; //Done
+
+      //Finished a directory. Go back up and carry on after it.
+      _log->changeDirectory("..");
+      depth--;
+      Level &level = levels[depth];
+      if (depth == 0) indexLog(level.directory, total - level.totalBefore);
+      _log->startListingAfter(cursor, (depth == 0) ? pattern : "*", level.directory, level.position);
+      continue;
+    }
+
+    //Take the files up to the first directory we'll go into
+    uint8_t used = 0;
+    uint8_t files = 0;
+    for ( ; used < count ; used++)
+    {
+      if (names[used][strlen(names[used]) - 1] != '/')
+        fileNames[files++] = names[used];
+      else if (depth < QOL_RETENTION_MAX_DEPTH)
+        break;
+      else if (depth == 0)
+        indexLog(names[used], 0); //Too deep to size
+    }
+
+    _log->size(fileNames, files, fileSizes);
+    for (uint8_t file = 0 ; file < files ; file++)
+    {
+      uint32_t kilobytes = 0;
+      if (fileSizes[file] > 0) kilobytes = (fileSizes[file] + 1023) / 1024;
+      total += kilobytes;
+      if (depth == 0) indexLog(fileNames[file], kilobytes);
+    }
+
+    if (used == count) continue; //No directory on this page
+
+    //Go into the directory. The rest of this page is listed again once we come back up.
+    uint8_t length = strlen(names[used]);
+    names[used][length - 1] = '\0';
+    boolean entered = changeDown(names[used]);
+    names[used][length - 1] = '/';
+
+    if (entered == false)
+    {
+      if (depth == 0) indexLog(names[used], 0);
+      _log->startListingAfter(cursor, (depth == 0) ? pattern : "*", names[used], pageStart + used);
+      continue;
+    }
+
+    Level &level = levels[depth];
+    strcpy(level.directory, names[used]);
+    level.position = pageStart + used;
+    level.totalBefore = total;
+    depth++;
+    _log->startListing(cursor, "*");
+  }
+
+  return (total);
+}
+
+//Add a log from the top level to the index if its name has a date
+void OpenLogRetention::indexLog(const char *name, uint32_t kilobytes)
+{
+  if (strlen(name) > QOL_RETENTION_NAME_LENGTH) return;
+
+  int32_t day = _dateFromName(name);
+  if (day >= 0) addEntry(name, day, kilobytes);
+}
+
+//Change into a directory and make sure it worked
+//If the cd had failed we would be sizing the wrong directory and then leaving it
+boolean OpenLogRetention::changeDown(const char *directoryName)
+{
+  if (_log->changeDirectory(directoryName) == false)
+    return (false);
+
+  uint8_t status = _log->getStatus();
+  return ((status & 1<<STATUS_LAST_COMMAND_KNOWN) && (status & 1<<STATUS_LAST_COMMAND_SUCCESS));
+}
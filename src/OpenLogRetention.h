@@ -0,0 +1,100 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Keeps the last N days or N kilobytes of logs on the SD card.
+
+  The current directory is listed once into a small index of names, sizes, and dates. Dates
+  come from the file names (LOG181023.TXT or 181023/ for example). Logs that break the policy
+  are then removed a few at a time from service() so logging never stops for a big cleanup.
+  Directories are removed with OpenLogRemover, a batch of files per service() call.
+  Files and directories without a date in their name are left alone.
+
+  The size limit is checked against everything the listing matched, including what is inside
+  directories and any dated logs past the end of the index. The index only decides what goes first.
+
+  inventory() walks the directories without recursing so its stack use doesn't grow with depth.
+  Sizing a page of files interrupts the listing. Firmware with QOL_FEATURE_LS_SKIP picks it up again
+  in one read. Older firmware reads the names ahead of the page again, which adds up on big directories.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+#include "OpenLogRemover.h"
+
+#define QOL_RETENTION_MAX_ENTRIES 32 //Number of dated logs we can track. Each entry takes 20 bytes.
+#define QOL_RETENTION_NAME_LENGTH 12 //8.3 names
+#define QOL_RETENTION_PAGE 8 //Names listed and sized at a time. Each takes about 17 bytes of stack during inventory().
+#define QOL_RETENTION_MAX_DEPTH 4 //Directories inside directories deeper than this aren't sized. Each level takes 20 bytes of stack.
+
+class OpenLogRetention {
+
+  public:
+    //dateFromName returns the day number for a name or -1 if the name has no date
+    //By default the first six digits in the name are read as YYMMDD
+    void begin(OpenLog &log, int32_t (*dateFromName)(const char *name) = NULL);
+
+    //List the current directory into the index and total up the size of everything that matches,
+    //going down into directories. Returns the number of dated entries.
+    uint8_t inventory(String pattern = "*");
+
+    void setToday(uint16_t today); //Day number for today. See dayNumber().
+    void setMaxAge(uint16_t days); //Remove logs older than this. 0 = no age limit.
+    void setMaxKilobytes(uint32_t kilobytes); //Remove the oldest logs until we are under this. 0 = no size limit.
+
+    //Remove logs that break the policy until timeBudget milliseconds have been used
+    //At least one log is removed per call if one needs to go
+    //Returns true if there is more to remove
+    boolean service(uint16_t timeBudget);
+
+    uint8_t getEntryCount(); //Number of dated logs in the index
+    uint32_t getTotalKilobytes(); //Size of everything inventory() found, less what has been removed
+    uint32_t getRemovedCount(); //Number of logs removed so far
+    boolean needsInventory(); //True if the index ran out of room and should be rebuilt once it's cleared
+
+    static uint16_t dayNumber(uint16_t year, uint8_t month, uint8_t day); //Days since January 1st, 2000
+    static int32_t dateFromYYMMDD(const char *name); //The default name parser
+
+  private:
+    struct Entry
+    {
+      char name[QOL_RETENTION_NAME_LENGTH + 1]; //Directories end in '/'
+      uint16_t day;
+      uint32_t kilobytes; //For directories, everything inside them
+    };
+
+    boolean addEntry(const char *name, uint16_t day, uint32_t kilobytes); //Add to the index in date order
+    boolean expired(const Entry &entry);
+    uint32_t listKilobytes(const char *pattern); //Size the current directory and everything in it, indexing dated logs at the top
+    void indexLog(const char *name, uint32_t kilobytes); //Add a top level log to the index if its name has a date
+    boolean changeDown(const char *directoryName); //cd and check OpenLog says it worked
+
+    OpenLog *_log;
+    int32_t (*_dateFromName)(const char *name);
+
+    Entry _entries[QOL_RETENTION_MAX_ENTRIES]; //Oldest first
+    uint8_t _entryCount = 0;
+    boolean _overflow = false; //We found more dated logs than we could track
+
+    uint16_t _today = 0;
+    uint16_t _maxAge = 0;
+    uint32_t _maxKilobytes = 0;
+    uint32_t _totalKilobytes = 0;
+    uint32_t _removedCount = 0;
+
+    OpenLogRemover _remover;
+    boolean _removingDirectory = false; //_entries[0] is a directory the remover is working on
+};
@@ -0,0 +1,159 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  A circular log over a fixed number of fixed-size segment files.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogRing.h"
+
+//Find the segment we were last recording to and continue from there
+//This checks the header of each segment once. Nothing is listed or sized after begin().
+boolean OpenLogRing::begin(OpenLog &log, String prefix, uint8_t segmentCount, uint32_t segmentSize)
+{
+  _log = &log;
+  _prefix = prefix;
+  _segmentCount = segmentCount;
+  _segmentSize = segmentSize;
+
+  if (_segmentCount < 2 || _segmentCount > QOL_RING_MAX_SEGMENTS) return (false);
+
+  //The segment with the highest generation is the one we were recording to
+  int32_t newest = -1;
+  for (uint8_t segment = 0 ; segment < _segmentCount ; segment++)
+  {
+    int32_t generation = readGeneration(segment);
+    if (generation > newest)
+    {
+      newest = generation;
+      _current = segment;
+    }
+  }
+
+  if (newest < 0)
+  {
+    //Nothing on the card yet. Start with the segment before 0 so that roll() begins at 0.
+    _current = _segmentCount - 1;
+    _generation = 0;
+    return (roll());
+  }
+
+  _generation = newest;
+
+  int32_t currentSize = _log->size(getSegmentName(_current));
+  if (currentSize < 0) return (false);
+  _currentSize = currentSize;
+
+  return (_log->append(getSegmentName(_current)));
+}
+
+//Record a string, moving to the next segment first if it doesn't fit in this one
+//We prefer to move at the start of a line so that lines are not split across segments
+size_t OpenLogRing::write(const uint8_t *buffer, size_t size)
+{
+  if ((_atLineStart == true && _currentSize + size > _segmentSize) || _currentSize >= _segmentSize)
+  {
+    if (roll() == false)
+      return (0);
+  }
+
+  size_t written = _log->writeRaw(buffer, size);
+  _currentSize += written;
+  if (written > 0) _atLineStart = (buffer[written - 1] == '\n');
+
+  return (written);
+}
+
+//Record a single character
+size_t OpenLogRing::write(uint8_t character)
+{
+  return (write(&character, 1));
+}
+
+//Return the segment we are recording to
+uint8_t OpenLogRing::getCurrentSegment()
+{
+  return (_current);
+}
+
+//Return the number of bytes in the current segment, including the header
+uint32_t OpenLogRing::getCurrentSize()
+{
+  return (_currentSize);
+}
+
+//Return the file name for a given segment: prefix + two digits + .LOG
+String OpenLogRing::getSegmentName(uint8_t segment)
+{
+  String name = _prefix;
+  if (segment < 10) name += "0";
+  name += String(segment);
+  name += ".LOG";
+  return (name);
+}
+
+//Move to the next segment
+//The old data in that segment is dropped with one remove and the file is recreated by append
+boolean OpenLogRing::roll()
+{
+  uint8_t next = (_current + 1) % _segmentCount;
+  uint32_t generation = _generation + 1;
+  if (_currentSize == 0) generation = _generation; //First segment on a fresh card
+
+  String name = getSegmentName(next);
+  _log->removeFile(name); //Remove will fail harmlessly if the segment doesn't exist yet
+  if (_log->append(name) == false) //Append creates the file
+    return (false);
+
+  String header = "#RING " + String(generation) + "\n";
+  if (_log->writeRaw((const uint8_t *)header.c_str(), header.length()) != header.length())
+    return (false);
+
+  _current = next;
+  _currentSize = header.length();
+  _atLineStart = true;
+  _generation = generation;
+
+  return (true);
+}
+
+//Read the "#RING <generation>" line at the start of a segment
+//Returns -1 if the segment is missing or doesn't start with a header
+int32_t OpenLogRing::readGeneration(uint8_t segment)
+{
+  String name = getSegmentName(segment);
+
+  int32_t fileSize = _log->size(name);
+  if (fileSize < 8) return (-1); //Missing or too short to hold a header
+
+  uint8_t header[17];
+  uint8_t toRead = sizeof(header);
+  if (fileSize < toRead) toRead = fileSize;
+  _log->read(header, toRead, name);
+
+  if (memcmp(header, "#RING ", 6) != 0) return (-1);
+
+  int32_t generation = 0;
+  for (uint8_t x = 6 ; x < toRead ; x++)
+  {
+    if (header[x] == '\n')
+      return (x == 6 ? -1 : generation);
+    if (header[x] < '0' || header[x] > '9') return (-1);
+    generation = generation * 10 + (header[x] - '0');
+    if (generation < 0) return (-1); //Too many digits
+  }
+
+  return (-1); //Header was never finished
+}
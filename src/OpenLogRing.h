@@ -0,0 +1,63 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  A circular log that never uses more than a fixed amount of the SD card.
+
+  Data is recorded to a set of segment files. When the current segment is full the oldest
+  segment is removed and recreated and logging continues there. The size of the current
+  segment is tracked locally so no listing or size commands are needed while logging.
+  Segments are changed between lines so a segment can go over its size by up to one write.
+  Data is recorded as is (see writeRaw()) so the tracked size matches the file exactly.
+
+  Each segment starts with a "#RING <generation>" line so that begin() can tell which
+  segment was being written last.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+
+#define QOL_RING_MAX_SEGMENTS 100 //Segment numbers are two digits
+
+class OpenLogRing : public Print {
+
+  public:
+    //Segments are named <prefix>00.LOG, <prefix>01.LOG, etc. Use a prefix of up to 6 characters.
+    //The card will hold at most segmentCount * segmentSize bytes of log.
+    boolean begin(OpenLog &log, String prefix, uint8_t segmentCount, uint32_t segmentSize);
+
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    virtual size_t write(uint8_t character);
+    using Print::write;
+
+    uint8_t getCurrentSegment(); //Returns the segment we are recording to
+    uint32_t getCurrentSize(); //Returns the number of bytes in the current segment
+    String getSegmentName(uint8_t segment); //Returns the file name for a given segment
+
+  private:
+    boolean roll(); //Recycle the oldest segment and start recording to it
+    int32_t readGeneration(uint8_t segment); //Returns the generation in the segment's header or -1
+
+    OpenLog *_log;
+    String _prefix;
+    uint8_t _segmentCount = 0;
+    uint32_t _segmentSize = 0;
+
+    uint8_t _current = 0; //Segment we are recording to
+    uint32_t _currentSize = 0; //Tracked locally so we never need to ask OpenLog
+    uint32_t _generation = 0; //Goes up by one each time we roll
+    boolean _atLineStart = true; //True if the last byte we recorded was a new line
+};
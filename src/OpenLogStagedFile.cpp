@@ -0,0 +1,107 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Per-file staging buffers so OpenLog switches files once per buffer instead of once per write.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogStagedFile.h"
+
+//Create a staged file on a given OpenLog
+OpenLogStagedFile::OpenLogStagedFile(OpenLog &log, String fileName, uint8_t *buffer, uint16_t bufferSize)
+{
+  _log = &log;
+  _fileName = fileName;
+  _buffer = buffer;
+  _bufferSize = (buffer == NULL) ? 0 : bufferSize; //No buffer means every write goes straight through
+}
+
+//Send the data now if OpenLog is recording to this file, otherwise hold it in our buffer
+size_t OpenLogStagedFile::write(const uint8_t *buffer, size_t size)
+{
+  //Nothing waiting and OpenLog is already on this file: no need to stage
+  if (_bufferUsed == 0 && _log->getCurrentFile() == _fileName)
+    return (_log->writeRaw(buffer, size));
+
+  //Nowhere to stage: send it now
+  if (_bufferSize == 0)
+    return (sendToFile(buffer, size));
+
+  size_t written = 0;
+  while (written < size)
+  {
+    uint16_t toCopy = _bufferSize - _bufferUsed;
+    if (size - written < toCopy) toCopy = size - written;
+
+    memcpy(&_buffer[_bufferUsed], &buffer[written], toCopy);
+    _bufferUsed += toCopy;
+    written += toCopy;
+
+    if (_bufferUsed == _bufferSize)
+    {
+      flush();
+      if (_bufferUsed > 0)
+        return (0); //Error: Sensor did not ack
+    }
+  }
+
+  return (size);
+}
+
+//Write a single character
+size_t OpenLogStagedFile::write(uint8_t character)
+{
+  return (write(&character, 1));
+}
+
+//Send the buffer to this file as contiguous chunks
+void OpenLogStagedFile::flush()
+{
+  if (_bufferUsed == 0) return; //Nothing waiting
+
+  if (sendToFile(_buffer, _bufferUsed) == _bufferUsed)
+    _bufferUsed = 0;
+}
+
+//Switch OpenLog to this file (if it isn't already), send the data, then point OpenLog back at
+//the file it was recording to so the sketch's next print() goes where it expects
+size_t OpenLogStagedFile::sendToFile(const uint8_t *data, size_t size)
+{
+  String previousFile = _log->getCurrentFile();
+
+  if (previousFile != _fileName)
+  {
+    if (_log->append(_fileName) == false)
+      return (0); //Error: Sensor did not ack
+    _switchCount++;
+  }
+
+  size_t written = _log->writeRaw(data, size);
+
+  //OpenLog's default log has no name to go back to
+  if (previousFile.length() > 0 && previousFile != _fileName)
+  {
+    _log->append(previousFile);
+    _switchCount++;
+  }
+
+  return (written);
+}
+
+//Return the number of append commands we've caused
+uint32_t OpenLogStagedFile::getSwitchCount()
+{
+  return (_switchCount);
+}
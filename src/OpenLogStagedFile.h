@@ -0,0 +1,58 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  Combines writes to a file that OpenLog isn't currently recording to.
+
+  OpenLog records to one file at a time and every switch costs an append command. A staged file
+  collects writes in its own buffer while OpenLog is busy with another file. When the buffer fills
+  (or on flush) OpenLog is switched to this file once, the whole buffer is sent, and OpenLog is
+  switched back to the file it was recording to. Writes to the file OpenLog is already recording
+  to go straight through. Data is sent as is (see writeRaw()).
+
+  OpenLog's default log (the one it opens at power up) has no name to switch back to. Give the
+  sketch's own log a name with append() before using staged files.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+
+class OpenLogStagedFile : public Print {
+
+  public:
+    //The buffer is supplied by the user. A few hundred bytes per file works well.
+    //With no buffer (NULL or 0 bytes) nothing is staged and each write switches OpenLog to this file and back.
+    OpenLogStagedFile(OpenLog &log, String fileName, uint8_t *buffer, uint16_t bufferSize);
+
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    virtual size_t write(uint8_t character);
+    using Print::write;
+    virtual void flush(); //Switch OpenLog to this file and send everything that is waiting
+
+    uint32_t getSwitchCount(); //Returns the number of append commands we've caused, counting the switches back
+
+  private:
+    size_t sendToFile(const uint8_t *data, size_t size); //Switch to this file, send, and switch back
+
+    OpenLog *_log;
+    String _fileName;
+
+    uint8_t *_buffer;
+    uint16_t _bufferSize;
+    uint16_t _bufferUsed = 0;
+
+    uint32_t _switchCount = 0;
+};
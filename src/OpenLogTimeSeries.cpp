@@ -0,0 +1,440 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  A time-series store with one file per hour and an index of checkpoints.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "OpenLogTimeSeries.h"
+
+#define INDEX_FILE_NAME F("INDEX.TS")
+
+//Record timestamps are stored least significant byte first
+static void putUint32(uint8_t *buffer, uint32_t value)
+{
+  for (uint8_t x = 0 ; x < 4 ; x++)
+    buffer[x] = value >> (8 * x);
+}
+
+static uint32_t getUint32(const uint8_t *buffer)
+{
+  uint32_t value = 0;
+  for (uint8_t x = 0 ; x < 4 ; x++)
+    value |= (uint32_t)buffer[x] << (8 * x);
+  return (value);
+}
+
+//Move into the store's directory and see how big the index is
+boolean OpenLogTimeSeries::begin(OpenLog &log, String directoryName)
+{
+  _log = &log;
+  _hour = QOL_TS_UNKNOWN;
+
+  _log->makeDirectory(directoryName); //This will fail harmlessly if the directory is already there
+  if (_log->changeDirectory(directoryName) == false)
+    return (false);
+
+  int32_t indexSize = _log->size(INDEX_FILE_NAME);
+  _indexRecords = 0;
+  _lastIndexedHour = 0;
+  if (indexSize <= 0) return (true);
+
+  //Pad a record torn by a power loss out to full length so the records after it line up
+  //The padding isn't hex so the record reads as the one before it
+  uint8_t torn = indexSize % QOL_TS_INDEX_RECORD;
+  if (torn > 0)
+  {
+    uint8_t padding[QOL_TS_INDEX_RECORD];
+    memset(padding, '-', sizeof(padding));
+    padding[QOL_TS_INDEX_RECORD - 1] = '\n';
+
+    uint8_t toWrite = QOL_TS_INDEX_RECORD - torn;
+    if (_log->append(INDEX_FILE_NAME) == false || _log->writeRaw(&padding[torn], toWrite) != toWrite)
+      return (false);
+    indexSize += toWrite;
+  }
+
+  _indexRecords = indexSize / QOL_TS_INDEX_RECORD;
+  _lastIndexedHour = readHour(_indexRecords - 1);
+
+  return (true);
+}
+
+//Record data with a timestamp
+//If this is a new hour the old partition is closed and a new one is started
+boolean OpenLogTimeSeries::record(uint32_t timestamp, const uint8_t *data, uint8_t length)
+{
+  uint32_t hour = timestamp / QOL_TS_PARTITION_SECONDS;
+
+  if (hour < _lastIndexedHour) return (false); //We can't go back to an old partition. The index has to stay in order.
+  if (hour != _hour)
+  {
+    if (roll(hour, timestamp) == false)
+      return (false);
+  }
+
+  //The first record we see in each checkpoint period marks where that period starts
+  uint8_t checkpoint = (timestamp % QOL_TS_PARTITION_SECONDS) / (QOL_TS_PARTITION_SECONDS / QOL_TS_CHECKPOINTS);
+  for (uint8_t x = 0 ; x <= checkpoint ; x++)
+  {
+    if (_checkpoints[x] == QOL_TS_UNKNOWN) _checkpoints[x] = _partitionSize;
+  }
+
+  uint8_t header[QOL_TS_RECORD_HEADER];
+  putUint32(header, timestamp);
+  header[4] = length;
+
+  //Stuff the record a chunk at a time
+  uint8_t chunk[I2C_BUFFER_LENGTH];
+  uint8_t chunkUsed = 0;
+  if (writeStuffed(header, sizeof(header), chunk, chunkUsed) == false || writeStuffed(data, length, chunk, chunkUsed) == false)
+    return (false);
+  if (chunkUsed > 0)
+  {
+    if (_log->writeRaw(chunk, chunkUsed) != chunkUsed)
+      return (false);
+    _partitionSize += chunkUsed;
+  }
+
+  return (true);
+}
+
+//Find every record in a time range
+//The index is searched for the first partition in the range. For each partition only the
+//bytes between the checkpoints that cover the range are read.
+uint32_t OpenLogTimeSeries::query(uint32_t start, uint32_t end, uint8_t *buffer, uint16_t bufferSize,
+                                  void (*recordFound)(uint32_t timestamp, const uint8_t *data, uint8_t length))
+{
+  if (end <= start) return (0);
+
+  _log->sync(); //OpenLog has to commit what we've recorded before we can read it back
+
+  uint32_t startHour = start / QOL_TS_PARTITION_SECONDS;
+  uint32_t endHour = (end - 1) / QOL_TS_PARTITION_SECONDS;
+  uint32_t found = 0;
+
+  //Binary search for the first index record at or after the start hour
+  uint32_t low = 0;
+  uint32_t high = _indexRecords;
+  while (low < high)
+  {
+    uint32_t middle = low + (high - low) / 2;
+    if (readHour(middle) < startHour)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  //A partition gets an index record when it is opened and another when it is closed
+  //Only the last record for each hour is used
+  uint32_t hour, partitionEnd;
+  uint32_t checkpoints[QOL_TS_CHECKPOINTS];
+  if (low < _indexRecords)
+    readIndexRecord(low, hour, checkpoints, partitionEnd);
+
+  for (uint32_t recordNumber = low ; recordNumber < _indexRecords && hour <= endHour ; recordNumber++)
+  {
+    uint32_t nextHour = QOL_TS_UNKNOWN;
+    uint32_t nextEnd;
+    uint32_t nextCheckpoints[QOL_TS_CHECKPOINTS];
+    if (recordNumber + 1 < _indexRecords)
+      readIndexRecord(recordNumber + 1, nextHour, nextCheckpoints, nextEnd);
+
+    //The partition we are recording to is handled from RAM below
+    if (nextHour != hour && hour != _hour)
+      found += queryPartition(hour, checkpoints, partitionEnd, start, end, buffer, bufferSize, recordFound);
+
+    hour = nextHour;
+    partitionEnd = nextEnd;
+    memcpy(checkpoints, nextCheckpoints, sizeof(checkpoints));
+  }
+
+  if (_hour != QOL_TS_UNKNOWN && _hour >= startHour && _hour <= endHour)
+    found += queryPartition(_hour, _checkpoints, _partitionSize, start, end, buffer, bufferSize, recordFound);
+
+  return (found);
+}
+
+//Write the closing index record for the current partition
+//Partitions that were never closed are still found. Queries read them from their last known
+//checkpoint (usually the start of the file) to the end.
+boolean OpenLogTimeSeries::close()
+{
+  if (_hour == QOL_TS_UNKNOWN) return (true); //Nothing open
+
+  for (uint8_t x = 0 ; x < QOL_TS_CHECKPOINTS ; x++)
+  {
+    if (_checkpoints[x] == QOL_TS_UNKNOWN) _checkpoints[x] = _partitionSize;
+  }
+
+  boolean result = _log->append(INDEX_FILE_NAME);
+  if (result == true)
+    result = writeIndexRecord(_hour, _checkpoints, _partitionSize);
+  if (result == true)
+    result = _log->sync();
+
+  _hour = QOL_TS_UNKNOWN;
+  return (result);
+}
+
+//Return the file name for an hour: six hex digits + .TS
+String OpenLogTimeSeries::getPartitionName(uint32_t hour)
+{
+  String name = String(hour, HEX);
+  while (name.length() < 6) name = "0" + name;
+  name += ".TS";
+  return (name);
+}
+
+//Close the current partition and start recording to the one for this hour
+boolean OpenLogTimeSeries::roll(uint32_t hour, uint32_t timestamp)
+{
+  boolean firstPartition = (_hour == QOL_TS_UNKNOWN);
+
+  if (_log->append(INDEX_FILE_NAME) == false)
+    return (false);
+
+  if (firstPartition == false)
+  {
+    for (uint8_t x = 0 ; x < QOL_TS_CHECKPOINTS ; x++)
+    {
+      if (_checkpoints[x] == QOL_TS_UNKNOWN) _checkpoints[x] = _partitionSize;
+    }
+    writeIndexRecord(_hour, _checkpoints, _partitionSize);
+  }
+
+  //Anything already in the new partition (from before a reset) could be from any time before now
+  //so those checkpoints point at the start of the file
+  uint8_t checkpoint = (timestamp % QOL_TS_PARTITION_SECONDS) / (QOL_TS_PARTITION_SECONDS / QOL_TS_CHECKPOINTS);
+  for (uint8_t x = 0 ; x < QOL_TS_CHECKPOINTS ; x++)
+    _checkpoints[x] = (x <= checkpoint) ? 0 : QOL_TS_UNKNOWN;
+
+  if (writeIndexRecord(hour, _checkpoints, QOL_TS_UNKNOWN) == false)
+    return (false);
+
+  String name = getPartitionName(hour);
+  if (_log->append(name) == false)
+    return (false);
+
+  _partitionSize = 0;
+  if (firstPartition == true)
+  {
+    //We may be picking up a partition after a reset
+    int32_t partitionSize = _log->size(name);
+    if (partitionSize > 0) _partitionSize = partitionSize;
+  }
+
+  _hour = hour;
+  return (true);
+}
+
+//Add data to the chunk, putting a QOL_TS_STUFFING byte after every QOL_TS_ESCAPE byte
+//Full chunks are sent as we go. The caller sends whatever is left.
+boolean OpenLogTimeSeries::writeStuffed(const uint8_t *data, uint8_t length, uint8_t *chunk, uint8_t &chunkUsed)
+{
+  for (uint8_t x = 0 ; x < length ; x++)
+  {
+    if (chunkUsed >= I2C_BUFFER_LENGTH - 1) //Leave room for a stuffing byte
+    {
+      if (_log->writeRaw(chunk, chunkUsed) != chunkUsed)
+        return (false);
+      _partitionSize += chunkUsed;
+      chunkUsed = 0;
+    }
+
+    chunk[chunkUsed++] = data[x];
+    if (data[x] == QOL_TS_ESCAPE)
+      chunk[chunkUsed++] = QOL_TS_STUFFING;
+  }
+  return (true);
+}
+
+//Take the stuffing back out of the record that starts the buffer. The record is decoded in place.
+//Returns the number of stored bytes the record took, or 0 if it doesn't finish in the buffer
+static uint16_t unstuffRecord(uint8_t *buffer, uint16_t available)
+{
+  uint16_t spot = 0;
+  uint16_t recordLength = 0;
+  uint16_t needed = QOL_TS_RECORD_HEADER;
+
+  while (recordLength < needed)
+  {
+    if (spot == available) return (0);
+    uint8_t incoming = buffer[spot++];
+    if (incoming == QOL_TS_ESCAPE)
+    {
+      if (spot == available) return (0);
+      spot++; //Skip the stuffing
+    }
+
+    buffer[recordLength++] = incoming;
+    if (recordLength == QOL_TS_RECORD_HEADER) needed += buffer[4]; //Now we know the length
+  }
+
+  return (spot);
+}
+
+//Append a record to the index. OpenLog must already be appending to INDEX.TS.
+//Each field is 8 upper case hex digits, most significant first, and the record ends with a new line
+boolean OpenLogTimeSeries::writeIndexRecord(uint32_t hour, const uint32_t checkpoints[], uint32_t end)
+{
+  const char hex[] = "0123456789ABCDEF";
+  uint32_t values[QOL_TS_INDEX_FIELDS];
+  uint8_t record[QOL_TS_INDEX_RECORD];
+
+  values[0] = hour;
+  for (uint8_t x = 0 ; x < QOL_TS_CHECKPOINTS ; x++)
+    values[1 + x] = checkpoints[x];
+  values[1 + QOL_TS_CHECKPOINTS] = end;
+
+  for (uint8_t field = 0 ; field < QOL_TS_INDEX_FIELDS ; field++)
+  {
+    for (uint8_t digit = 0 ; digit < 8 ; digit++)
+      record[8 * field + digit] = hex[(values[field] >> (28 - 4 * digit)) & 0x0F];
+  }
+  record[QOL_TS_INDEX_RECORD - 1] = '\n';
+
+  if (_log->writeRaw(record, sizeof(record)) != sizeof(record))
+    return (false);
+
+  _indexRecords++;
+  _lastIndexedHour = hour;
+  return (true);
+}
+
+//Read one index record
+//A record torn by a power loss reads as the record before it. If there is none, it reads as
+//hour 0 with nothing recorded.
+void OpenLogTimeSeries::readIndexRecord(uint32_t recordNumber, uint32_t &hour, uint32_t checkpoints[], uint32_t &end)
+{
+  uint32_t values[QOL_TS_INDEX_FIELDS];
+
+  while (parseIndexRecord(recordNumber, values) == false)
+  {
+    if (recordNumber == 0)
+    {
+      values[0] = 0;
+      for (uint8_t x = 1 ; x < QOL_TS_INDEX_FIELDS ; x++)
+        values[x] = QOL_TS_UNKNOWN;
+      break;
+    }
+    recordNumber--;
+  }
+
+  hour = values[0];
+  for (uint8_t x = 0 ; x < QOL_TS_CHECKPOINTS ; x++)
+    checkpoints[x] = values[1 + x];
+  end = values[1 + QOL_TS_CHECKPOINTS];
+}
+
+//Read and decode the hex fields of an index record
+//Returns false if the record isn't all hex digits followed by a new line
+boolean OpenLogTimeSeries::parseIndexRecord(uint32_t recordNumber, uint32_t values[])
+{
+  uint8_t record[QOL_TS_INDEX_RECORD];
+  _log->read(record, sizeof(record), INDEX_FILE_NAME, recordNumber * QOL_TS_INDEX_RECORD);
+
+  if (record[QOL_TS_INDEX_RECORD - 1] != '\n') return (false);
+
+  for (uint8_t field = 0 ; field < QOL_TS_INDEX_FIELDS ; field++)
+  {
+    uint32_t value = 0;
+    for (uint8_t digit = 0 ; digit < 8 ; digit++)
+    {
+      uint8_t character = record[8 * field + digit];
+      if (character >= '0' && character <= '9') value = (value << 4) | (character - '0');
+      else if (character >= 'A' && character <= 'F') value = (value << 4) | (character - 'A' + 10);
+      else return (false);
+    }
+    values[field] = value;
+  }
+
+  return (true);
+}
+
+//Read just the hour of an index record
+//The whole record is read so a torn record gives the same answer here as in readIndexRecord()
+uint32_t OpenLogTimeSeries::readHour(uint32_t recordNumber)
+{
+  uint32_t hour, end;
+  uint32_t checkpoints[QOL_TS_CHECKPOINTS];
+  readIndexRecord(recordNumber, hour, checkpoints, end);
+  return (hour);
+}
+
+//Read the records in one partition that fall between start and stop
+uint32_t OpenLogTimeSeries::queryPartition(uint32_t hour, const uint32_t checkpoints[], uint32_t end, uint32_t start, uint32_t stop,
+    uint8_t *buffer, uint16_t bufferSize,
+    void (*recordFound)(uint32_t timestamp, const uint8_t *data, uint8_t length))
+{
+  const uint32_t period = QOL_TS_PARTITION_SECONDS / QOL_TS_CHECKPOINTS;
+  uint32_t hourStart = hour * QOL_TS_PARTITION_SECONDS;
+  String name = getPartitionName(hour);
+
+  //Start reading at the checkpoint that covers the start of the range
+  //A partition that was never closed is missing its later checkpoints, so go back to the last one
+  //it has (or the start of the file) and read forward from there
+  uint32_t from = (start > hourStart) ? start - hourStart : 0;
+  uint8_t first = from / period;
+  while (first > 0 && checkpoints[first] == QOL_TS_UNKNOWN) first--;
+  uint32_t offset = checkpoints[first];
+  if (offset == QOL_TS_UNKNOWN) offset = 0;
+
+  //Stop at the first checkpoint after the end of the range
+  uint32_t readEnd = end;
+  if (stop - hourStart < QOL_TS_PARTITION_SECONDS)
+  {
+    uint8_t checkpoint = (stop - 1 - hourStart) / period + 1;
+    if (checkpoint < QOL_TS_CHECKPOINTS && checkpoints[checkpoint] != QOL_TS_UNKNOWN)
+      readEnd = checkpoints[checkpoint];
+  }
+  if (readEnd == QOL_TS_UNKNOWN)
+  {
+    //This partition was never closed
+    int32_t partitionSize = _log->size(name);
+    if (partitionSize < 0) return (0);
+    readEnd = partitionSize;
+  }
+
+  uint32_t found = 0;
+  while (offset < readEnd)
+  {
+    uint16_t toRead = bufferSize;
+    if (readEnd - offset < toRead) toRead = readEnd - offset;
+
+    _log->read(buffer, toRead, name, offset);
+
+    //Hand over every complete record in the buffer
+    uint16_t spot = 0;
+    while (spot < toRead)
+    {
+      uint16_t stored = unstuffRecord(&buffer[spot], toRead - spot);
+      if (stored == 0) break; //Record continues in the next read
+
+      uint32_t timestamp = getUint32(&buffer[spot]);
+      if (timestamp >= start && timestamp < stop)
+      {
+        recordFound(timestamp, &buffer[spot + QOL_TS_RECORD_HEADER], buffer[spot + 4]);
+        found++;
+      }
+      spot += stored;
+    }
+
+    if (spot == 0) break; //Buffer is too small for this record
+    offset += spot;
+  }
+
+  return (found);
+}
@@ -0,0 +1,88 @@
+/*
+  This is a library written for the Qwiic OpenLog
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14641
+
+  A time-series store that splits records into one file per hour.
+
+  All files live in one directory. Each partition is named for its hour (hours since time 0 in hex,
+  for example 06C5A3.TS) and holds binary records: a 4 byte timestamp, a 1 byte length, and the data.
+  INDEX.TS holds a line for each partition: the hour, the file offset at each 10 minute checkpoint,
+  and the final size of the partition, each as 8 hex digits. A query reads the index, then reads just
+  the part of each partition that covers the time range.
+
+  Three 0x1A bytes in a row put OpenLog into command mode, so every 0x1A in a partition is followed
+  by a 0x00 that is taken out again when the partition is read. Offsets in the index count these
+  extra bytes. The index is text so it never holds a 0x1A. Records and the index are written with
+  writeRaw(), so OpenLog's line timestamps, sequence numbers, and CRCs never end up in them.
+
+  The index is searched with a binary search so it has to stay in hour order. After a reset, records
+  for an hour before the last one in the index are refused.
+
+  Moving to the next hour costs two commands: append to the index (closing the old partition and
+  opening the new one), then append to the new partition.
+
+  https://github.com/sparkfun/SparkFun_Qwiic_OpenLog_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_Qwiic_OpenLog_Arduino_Library.h"
+
+#define QOL_TS_PARTITION_SECONDS 3600 //One file per hour
+#define QOL_TS_CHECKPOINTS 6 //Checkpoints per partition. 6 is one every 10 minutes.
+#define QOL_TS_RECORD_HEADER 5 //4 byte timestamp + 1 byte length
+#define QOL_TS_INDEX_FIELDS (QOL_TS_CHECKPOINTS + 2) //Hour, checkpoints, and end of partition
+#define QOL_TS_INDEX_RECORD (8 * QOL_TS_INDEX_FIELDS + 1) //8 hex digits for each field and a new line
+#define QOL_TS_ESCAPE 0x1A //OpenLog's escape character. Followed by QOL_TS_STUFFING in partitions.
+#define QOL_TS_STUFFING 0x00
+#define QOL_TS_UNKNOWN 0xFFFFFFFF //An offset we haven't reached yet
+
+class OpenLogTimeSeries {
+
+  public:
+    //The store takes over OpenLog. All records go into the given directory.
+    boolean begin(OpenLog &log, String directoryName);
+
+    //Record data with a timestamp in seconds. Timestamps must not go back to an earlier hour.
+    boolean record(uint32_t timestamp, const uint8_t *data, uint8_t length);
+
+    //Find every record with start <= timestamp < end
+    //The buffer is used to read the partitions and must hold at least one full record as stored: twice
+    //the record's 5 + length bytes covers a record made entirely of 0x1A bytes
+    //Returns the number of records found
+    uint32_t query(uint32_t start, uint32_t end, uint8_t *buffer, uint16_t bufferSize,
+                   void (*recordFound)(uint32_t timestamp, const uint8_t *data, uint8_t length));
+
+    boolean close(); //Record the index entry for the current partition. Call before power down.
+
+    String getPartitionName(uint32_t hour); //Returns the file name for a given hour
+
+  private:
+    boolean roll(uint32_t hour, uint32_t timestamp); //Close the current partition and open the one for this hour
+    boolean writeStuffed(const uint8_t *data, uint8_t length, uint8_t *chunk, uint8_t &chunkUsed); //Add to a record being written, escaping 0x1A
+    boolean writeIndexRecord(uint32_t hour, const uint32_t checkpoints[], uint32_t end);
+    void readIndexRecord(uint32_t recordNumber, uint32_t &hour, uint32_t checkpoints[], uint32_t &end);
+    boolean parseIndexRecord(uint32_t recordNumber, uint32_t values[]); //Returns false if the record is torn
+    uint32_t readHour(uint32_t recordNumber);
+    uint32_t queryPartition(uint32_t hour, const uint32_t checkpoints[], uint32_t end, uint32_t start, uint32_t stop,
+                            uint8_t *buffer, uint16_t bufferSize,
+                            void (*recordFound)(uint32_t timestamp, const uint8_t *data, uint8_t length));
+
+    OpenLog *_log;
+
+    uint32_t _hour = QOL_TS_UNKNOWN; //Hour of the partition we are recording to
+    uint32_t _partitionSize = 0; //Tracked locally
+    uint32_t _checkpoints[QOL_TS_CHECKPOINTS]; //Offset of the first record in each checkpoint period
+    uint32_t _indexRecords = 0; //Number of records in INDEX.TS
+    uint32_t _lastIndexedHour = 0; //Hour of the last record in INDEX.TS. Earlier hours are refused.
+};
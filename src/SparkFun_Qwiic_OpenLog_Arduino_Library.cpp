@@ -43,6 +43,17 @@ boolean OpenLog::begin(uint8_t deviceAddress, TwoWire &wirePort)
   if(status & 1<<STATUS_SD_INIT_GOOD)
   {
     //We are good to go!
+    //Find out what the firmware can do so we can use the fastest way of talking to it
+    readVersion();
+    _features = 0;
+    if (_versionMajor >= QOL_CAPABILITY_VERSION)
+    {
+      sendCommand(F("cap"));
+      //Upon completion Qwiic OpenLog will have 1 byte of feature bits ready to be read
+      _i2cPort->requestFrom(_deviceAddress, (uint8_t)1);
+      if (_i2cPort->available())
+        _features = _i2cPort->read();
+    }
     return(true);
   }
 
@@ -57,15 +68,42 @@ boolean OpenLog::begin(int deviceAddress)
 
 //Get the version number from OpenLog
 String OpenLog::getVersion()
+{
+  if (_versionMajor == 0) readVersion(); //begin() normally does this
+
+  return(String(_versionMajor) + "." + String(_versionMinor));
+}
+
+uint8_t OpenLog::getVersionMajor()
+{
+  return (_versionMajor);
+}
+
+uint8_t OpenLog::getVersionMinor()
+{
+  return (_versionMinor);
+}
+
+//Returns the QOL_FEATURE_ bits the firmware reported in begin()
+uint8_t OpenLog::getFeatures()
+{
+  return (_features);
+}
+
+boolean OpenLog::hasFeature(uint8_t feature)
+{
+  return ((_features & (1 << feature)) != 0);
+}
+
+//Ask OpenLog for its version and keep it
+void OpenLog::readVersion()
 {
   sendCommand(F("ver"));
   //Upon completion Qwiic OpenLog will have 2 bytes ready to be read
   _i2cPort->requestFrom(_deviceAddress, (uint8_t)2);
 
-  uint8_t versionMajor = _i2cPort->read();
-  uint8_t versionMinor = _i2cPort->read();
-
-  return(String(versionMajor) + "." + String(versionMinor));
+  _versionMajor = _i2cPort->read();
+  _versionMinor = _i2cPort->read();
 }
 
 //Get the status byte from OpenLog
@@ -105,8 +143,22 @@ boolean OpenLog::setI2CAddress(uint8_t addr)
 //Append to a given file. If it doesn't exist it will be created
 boolean OpenLog::append(String fileName)
 {
-  return (sendCommand(F("append"), fileName));
+  flush(); //Finish with the current log before we restart our sector count
+  if (sendCommand(F("append"), fileName) == false)
+    return (false);
   //Upon completion any new characters sent to OpenLog will be recorded to this file
+
+  _currentFile = fileName;
+  findSectorOffset();
+  if (_verifyEvery > 0) startFileChecksum();
+  return (true);
+}
+
+//Return the name of the file OpenLog is recording to
+//Returns "" if we haven't called append() (OpenLog is recording to its default log)
+const String &OpenLog::getCurrentFile()
+{
+  return (_currentFile);
 }
 
 //Create a given file in the current directory
@@ -151,6 +203,59 @@ int32_t OpenLog::size(String fileName)
   return (fileSize);
 }
 
+//Read the sizes of a list of files
+//The log is flushed once and then each size command and its 4 byte response go back to back.
+//Names are sent straight from the caller's strings so nothing is allocated.
+//fileSizes[x] is set to -1 if the file doesn't exist or OpenLog didn't respond.
+//Returns the number of files found
+uint16_t OpenLog::size(const char *const fileNames[], uint16_t count, int32_t fileSizes[])
+{
+  const char command[] = "size ";
+  uint16_t found = 0;
+
+  flush(); //Anything waiting to be written belongs to the log that is currently open
+
+  for (uint16_t x = 0 ; x < count ; x++)
+  {
+    fileSizes[x] = -1;
+
+    uint8_t nameLength = strlen(fileNames[x]);
+    _commandCount++;
+    _escapeRun = 0;
+
+    _i2cPort->beginTransmission(_deviceAddress);
+    for (uint8_t y = 0 ; y < _escapeCharacterCount ; y++)
+      _i2cPort->write(_escapeCharacter);
+    if (hasFeature(QOL_FEATURE_BINARY_COMMANDS))
+    {
+      _i2cPort->write(QOL_BINARY_COMMAND);
+      _i2cPort->write(sizeof(command) - 1 + nameLength);
+      _i2cPort->write((const uint8_t *)command, sizeof(command) - 2);
+      _i2cPort->write((uint8_t)'\0'); //In place of the space
+    }
+    else
+      _i2cPort->write((const uint8_t *)command, sizeof(command) - 1);
+    _i2cPort->write((const uint8_t *)fileNames[x], nameLength);
+    if (_i2cPort->endTransmission() != 0)
+      continue; //Error: Sensor did not ack
+
+    if (_i2cPort->requestFrom(_deviceAddress, (uint8_t)4) != 4)
+      continue;
+
+    int32_t fileSize = 0;
+    for (uint8_t y = 0 ; y < 4 ; y++)
+    {
+      fileSize <<= 8;
+      fileSize |= _i2cPort->read();
+    }
+
+    fileSizes[x] = fileSize;
+    if (fileSize >= 0) found++;
+  }
+
+  return (found);
+}
+
 //Read the contents of a file, up to the size of the buffer, into a given array, from the start of the file
 void OpenLog::read(uint8_t* userBuffer, uint16_t bufferSize, String fileName)
 {
@@ -158,7 +263,7 @@ void OpenLog::read(uint8_t* userBuffer, uint16_t bufferSize, String fileName)
 }
 
 //Read the contents of a file, up to the size of the buffer, into a given array, from a given spot
-void OpenLog::read(uint8_t* userBuffer, uint16_t bufferSize, String fileName, uint16_t startingSpot)
+void OpenLog::read(uint8_t* userBuffer, uint16_t bufferSize, String fileName, uint32_t startingSpot)
 {
   uint16_t spotInBuffer = 0;
   uint16_t leftToRead = bufferSize; //Read up to the size of our buffer. We may go past EOF.
@@ -184,7 +289,36 @@ void OpenLog::read(uint8_t* userBuffer, uint16_t bufferSize, String fileName, ui
 //Returns true if OpenLog ack'd. Use getNextDirectoryItem() to get the first item.
 boolean OpenLog::searchDirectory(String options)
 {
-  if (sendCommand(F("ls"), options) == true)
+  return (startSearch(options, 0));
+}
+
+//Send ls for a search
+//Firmware with QOL_FEATURE_LS_SKIP leaves out the first skip names itself. Older firmware ignores skip
+//and lists from the top.
+boolean OpenLog::startSearch(String options, uint16_t skip)
+{
+  //Firmware that can pack several names into each response is asked to with -p
+  _packedListing = hasFeature(QOL_FEATURE_PACKED_LS);
+  _listingUsed = 0;
+  _listingSpot = 0;
+
+  String flags = "";
+  if (_packedListing == true)
+    flags = "-p";
+  if (skip > 0 && hasFeature(QOL_FEATURE_LS_SKIP))
+  {
+    if (flags.length() == 0) flags = "-";
+    flags += "s";
+    flags += String(skip);
+  }
+
+  boolean result;
+  if (flags.length() > 0)
+    result = sendCommand(F("ls"), flags, options);
+  else
+    result = sendCommand(F("ls"), options);
+
+  if (result == true)
   {
     _searchStarted = true;
     return (true);
@@ -194,6 +328,147 @@ boolean OpenLog::searchDirectory(String options)
   return (false);
 }
 
+//Get ready to list the current directory a page at a time
+void OpenLog::startListing(OpenLogListCursor &cursor, const char *options)
+{
+  strncpy(cursor.options, options, QOL_MAX_NAME_LENGTH);
+  cursor.options[QOL_MAX_NAME_LENGTH] = '\0';
+  cursor.lastName[0] = '\0';
+  cursor.nextName[0] = '\0';
+  cursor.index = 0;
+  cursor.position = 0;
+  cursor.commandStamp = 0;
+  cursor.searching = false;
+  cursor.done = false;
+}
+
+//Get ready to carry on a listing from just after a name that was at the given position in it
+//The first page finds the name again the same way listPage() does after another command
+void OpenLog::startListingAfter(OpenLogListCursor &cursor, const char *options, const char *name, uint16_t position)
+{
+  startListing(cursor, options);
+  strncpy(cursor.lastName, name, QOL_MAX_NAME_LENGTH);
+  cursor.lastName[QOL_MAX_NAME_LENGTH] = '\0';
+  cursor.position = position + 1;
+}
+
+//Fill names with up to maxNames entries from the listing and return how many there are
+//Each page reads one name ahead and keeps it in the cursor to start the next page. If nothing else
+//has talked to OpenLog since the last page the search simply carries on. Otherwise ls is sent again
+//and we look for that name. If it's gone we carry on after the last name we handed out instead. If
+//both are gone the listing starts over, so a name may be handed out twice but none are missed.
+uint8_t OpenLog::listPage(OpenLogListCursor &cursor, OpenLogName names[], uint8_t maxNames)
+{
+  if (cursor.done == true || maxNames == 0) return (0);
+
+  boolean haveNext = (cursor.nextName[0] != '\0'); //nextName starts this page
+  uint16_t start = cursor.position; //Position of the first name on this page
+
+  if (cursor.searching == false || _searchStarted == false || _commandCount != cursor.commandStamp)
+  {
+    //Our search was interrupted (or never started). Find our place again.
+    cursor.searching = true;
+    boolean found = false;
+    if (haveNext == true)
+    {
+      found = findName(cursor.options, cursor.nextName, start); //Leaves the search just past nextName
+      if (found == false)
+        haveNext = false; //nextName is gone
+    }
+    if (found == false && cursor.lastName[0] != '\0')
+    {
+      //Carry on after the last name we handed out, which came just before nextName
+      start = (cursor.position > 0) ? cursor.position - 1 : 0;
+      found = findName(cursor.options, cursor.lastName, start);
+      start++;
+    }
+
+    if (found == false)
+    {
+      haveNext = false;
+      start = 0;
+      if (searchDirectory(cursor.options) == false)
+      {
+        cursor.searching = false;
+        return (0); //Error: Sensor did not ack
+      }
+    }
+  }
+
+  uint8_t count = 0;
+  if (haveNext == true)
+    strcpy(names[count++], cursor.nextName);
+
+  while (count < maxNames)
+  {
+    String name = getNextDirectoryItem();
+    if (name.length() == 0)
+    {
+      cursor.done = true;
+      break;
+    }
+
+    name.toCharArray(names[count], sizeof(OpenLogName));
+    count++;
+  }
+
+  if (count > 0)
+  {
+    strcpy(cursor.lastName, names[count - 1]);
+    cursor.index += count;
+  }
+  cursor.position = start + count;
+
+  //Read ahead so the next page has a name to look for that we haven't handed out yet
+  if (cursor.done == false)
+  {
+    String name = getNextDirectoryItem();
+    if (name.length() == 0)
+      cursor.done = true;
+    else
+      name.toCharArray(cursor.nextName, sizeof(OpenLogName));
+  }
+
+  cursor.commandStamp = _commandCount;
+  return (count);
+}
+
+//Send ls and read the listing until we reach the given name
+//position is where the name was last seen. Firmware with QOL_FEATURE_LS_SKIP is asked to skip the names
+//ahead of it, so if nothing before it has changed the name costs a single read. Otherwise (and on older
+//firmware) the listing is read from the top, a read for every name ahead of it.
+//Names are compared the way listPage() stores them, cut to QOL_MAX_NAME_LENGTH
+//Returns true with the search just past the name and position set to where it was found,
+//or false if the name isn't there
+boolean OpenLog::findName(const char *options, const char *wanted, uint16_t &position)
+{
+  OpenLogName name;
+
+  if (position > 0 && hasFeature(QOL_FEATURE_LS_SKIP))
+  {
+    if (startSearch(options, position) == false)
+      return (false);
+
+    String item = getNextDirectoryItem();
+    item.toCharArray(name, sizeof(name));
+    if (item.length() > 0 && strcmp(name, wanted) == 0) return (true);
+  }
+
+  if (startSearch(options, 0) == false)
+    return (false);
+
+  position = 0;
+  while (true)
+  {
+    String item = getNextDirectoryItem();
+    if (item.length() == 0) return (false);
+
+    item.toCharArray(name, sizeof(name));
+    if (strcmp(name, wanted) == 0) return (true);
+    position++;
+  }
+}
+
 //Returns the name of the next file or directory folder in the current directory
 //Returns "" if it is the end of the list
 String OpenLog::getNextDirectoryItem()
@@ -201,6 +476,41 @@ String OpenLog::getNextDirectoryItem()
   if (_searchStarted == false) return (""); //We haven't done a search yet
 
   String itemName = "";
+
+  if (_packedListing == true)
+  {
+    //Each response is packed with \0 terminated names and a name may carry on into the next
+    //response. The rest of the response is kept for the next call. 0xFF where a name would start
+    //marks the end of the listing.
+    while (true)
+    {
+      if (_listingSpot == _listingUsed)
+      {
+        _listingUsed = 0;
+        _listingSpot = 0;
+        _i2cPort->requestFrom(_deviceAddress, (uint8_t)I2C_BUFFER_LENGTH);
+        while (_i2cPort->available() && _listingUsed < I2C_BUFFER_LENGTH)
+          _listing[_listingUsed++] = _i2cPort->read();
+
+        if (_listingUsed == 0)
+        {
+          _searchStarted = false;
+          return (""); //Error: Sensor did not respond
+        }
+      }
+
+      uint8_t incoming = _listing[_listingSpot++];
+      if (incoming == '\0')
+        return (itemName);
+      if (incoming == 0xFF && itemName.length() == 0)
+      {
+        _searchStarted = false;
+        return (""); //End of the directory listing
+      }
+      itemName += (char)incoming;
+    }
+  }
+
   _i2cPort->requestFrom(_deviceAddress, (uint8_t)I2C_BUFFER_LENGTH);
 
   uint8_t charsReceived = 0;
@@ -228,14 +538,14 @@ String OpenLog::getNextDirectoryItem()
 
 //Remove a file, wildcards supported
 //OpenLog will respond with the number of items removed
-uint32_t OpenLog::removeFile(String thingToDelete)
+int32_t OpenLog::removeFile(String thingToDelete)
 {
 	return(remove(thingToDelete, false));
 }
 
 //Remove a directory, wildcards supported
 //OpenLog will respond with 1 when removing a directory
-uint32_t OpenLog::removeDirectory(String thingToDelete)
+int32_t OpenLog::removeDirectory(String thingToDelete)
 {
 	return(remove(thingToDelete, true)); //Delete all files in the directory as well
 }
@@ -243,7 +553,7 @@ uint32_t OpenLog::removeDirectory(String thingToDelete)
 //Remove a file or directory (including everything in that directory)
 //OpenLog will respond with the number of items removed
 //Returns 1 if only a directory is removed (even if directory had files in it)
-uint32_t OpenLog::remove(String thingToDelete, boolean removeEverything)
+int32_t OpenLog::remove(String thingToDelete, boolean removeEverything)
 {
   if(removeEverything == true)
 	sendCommand(F("rm"), F("-rf"), thingToDelete); //-rf causes any directory to remove contents as well
@@ -284,11 +594,44 @@ boolean OpenLog::sendCommand(String command, String option1)
 //Send a command to the unit with options (such as "append myfile.txt" or "read myfile.txt 10")
 boolean OpenLog::sendCommand(String command, String option1, String option2)
 {
+  flush(); //Anything waiting to be written belongs to the log that is currently open
+  if (_writeBufferUsed > 0)
+    return (false); //Error: The data that goes before this command couldn't be sent
+  _commandCount++;
+  _escapeRun = 0; //OpenLog starts counting again after a command
+
   _i2cPort->beginTransmission(_deviceAddress);
 
   for (uint8_t x = 0 ; x < _escapeCharacterCount ; x++)
     _i2cPort->write(_escapeCharacter); //Send the necessary escape characters
 
+  if (hasFeature(QOL_FEATURE_BINARY_COMMANDS))
+  {
+    //Binary command: marker, length, then the command and options separated by NULs
+    //OpenLog doesn't have to search for spaces, and names may contain them
+    uint8_t length = command.length();
+    if (option1.length() > 0) length += 1 + option1.length();
+    if (option2.length() > 0) length += 1 + option2.length();
+
+    _i2cPort->write(QOL_BINARY_COMMAND);
+    _i2cPort->write(length);
+    _i2cPort->print(command);
+    if (option1.length() > 0)
+    {
+      _i2cPort->write((uint8_t)'\0');
+      _i2cPort->print(option1);
+    }
+    if (option2.length() > 0)
+    {
+      _i2cPort->write((uint8_t)'\0');
+      _i2cPort->print(option2);
+    }
+
+    if (_i2cPort->endTransmission() != 0)
+      return (false);
+    return (true);
+  }
+
   _i2cPort->print(command);
   if (option1.length() > 0)
   {
@@ -310,10 +653,10 @@ boolean OpenLog::sendCommand(String command, String option1, String option2)
 
 //Write a single character to Qwiic OpenLog
 size_t OpenLog::write(uint8_t character) {
-  _i2cPort->beginTransmission(_deviceAddress);
-  _i2cPort->write(character);
-  if (_i2cPort->endTransmission() != 0)
+  if (stageByte(character) == false)
     return (0); //Error: Sensor did not ack
+  if (endChunk() == false)
+    return (0);
 
   return (1);
 }
@@ -321,29 +664,117 @@ size_t OpenLog::write(uint8_t character) {
 //Write a string to Qwiic OpenLong
 //The common Arduinos have a limit of 32 bytes per I2C write
 //This splits writes up into I2C_BUFFER_LENGTH sized chunks
-size_t OpenLog::write(uint8_t *buffer, size_t size) {
+size_t OpenLog::write(const uint8_t *buffer, size_t size) {
 
-  uint8_t startPoint = 0;
-  const char subBuffer[I2C_BUFFER_LENGTH];
-  
-  while (startPoint < size)
+  for (size_t x = 0 ; x < size ; x++)
   {
-    //Pick the smaller of 32 or the remaining number of characters to send
-    byte endPoint = startPoint + I2C_BUFFER_LENGTH;
-    if (endPoint > size) endPoint = size;
+    if (stageByte(buffer[x]) == false)
+      return (0); //Error: Sensor did not ack
+  }
 
-    //Copy a subset of the buffer to a temp sub buffer
-    memcpy(subBuffer, &buffer[startPoint], endPoint - startPoint);
+  if (endChunk() == false)
+    return (0);
 
-    _i2cPort->beginTransmission(_deviceAddress);
-    _i2cPort->print(subBuffer); //Send the subBuffer
-    if (_i2cPort->endTransmission() != 0)
+  return (size);
+}
+
+//Write bytes as they are, without timestamps, sequence numbers, or line CRCs
+//Returns the number of bytes written or 0 if there was an error or the bytes would have
+//put OpenLog into command mode
+size_t OpenLog::writeRaw(const uint8_t *buffer, size_t size) {
+
+  if (queueRaw(buffer, size) == false)
+    return (0); //Error: Sensor did not ack
+
+  if (endChunk() == false)
+    return (0);
+
+  return (size);
+}
+
+//Write a record made of several pieces (header, payload, checksum, etc)
+//The pieces are packed straight into I2C_BUFFER_LENGTH transactions that cross from one
+//piece to the next so there is no need to copy them into one buffer first
+//Records are usually binary so they are sent as is, like writeRaw()
+//Returns the total number of bytes written or 0 if there was an error
+size_t OpenLog::writev(const OpenLogFragment *fragments, uint8_t fragmentCount) {
+
+  size_t total = 0;
+
+  //Check the whole record first so we never send part of it
+  uint8_t run = _escapeRun;
+  for (uint8_t fragment = 0 ; fragment < fragmentCount ; fragment++)
+  {
+    run = escapeRunAfter(fragments[fragment].data, fragments[fragment].length, run);
+    if (run >= _escapeCharacterCount)
+      return (0); //Error: OpenLog would go into command mode
+  }
+
+  for (uint8_t fragment = 0 ; fragment < fragmentCount ; fragment++)
+  {
+    if (queueRaw(fragments[fragment].data, fragments[fragment].length) == false)
       return (0); //Error: Sensor did not ack
+    total += fragments[fragment].length;
+  }
+
+  if (endChunk() == false)
+    return (0);
+
+  return (total);
+}
+
+//Write a string that is stored in flash
+//Print reads these one byte at a time and calls write() for each one which costs a
+//transaction per character. Here the bytes are read from flash straight into the Wire
+//buffer so a line costs one transaction per I2C_BUFFER_LENGTH bytes and uses no RAM.
+size_t OpenLog::write(const __FlashStringHelper *flashString) {
+
+  size_t length = queueFlash(flashString);
+
+  if (endChunk() == false)
+    return (0);
+
+  return (length);
+}
+
+//print(F("...")) goes through our chunked flash write
+size_t OpenLog::print(const __FlashStringHelper *flashString) {
+  return (write(flashString));
+}
+
+//println(F("...")) sends the new line in the same transaction as the end of the string
+size_t OpenLog::println(const __FlashStringHelper *flashString) {
+
+  size_t length = queueFlash(flashString);
+  if (length == 0 && pgm_read_byte(reinterpret_cast<PGM_P>(flashString)) != '\0')
+    return (0); //Error: Sensor did not ack
+
+  if (stageByte('\r') == false || stageByte('\n') == false)
+    return (0);
+
+  if (endChunk() == false)
+    return (0);
+
+  return (length + 2);
+}
+
+//Pack a string from flash into the outgoing data
+size_t OpenLog::queueFlash(const __FlashStringHelper *flashString)
+{
+  PGM_P spot = reinterpret_cast<PGM_P>(flashString);
+  size_t length = 0;
 
-    startPoint = endPoint; //Advance the start point
+  while (true)
+  {
+    uint8_t character = pgm_read_byte(spot++);
+    if (character == '\0') break;
+
+    if (stageByte(character) == false)
+      return (0); //Error: Sensor did not ack
+    length++;
   }
 
-  return (size);
+  return (length);
 }
 
 //Write a string to Qwiic OpenLong
@@ -351,20 +782,712 @@ size_t OpenLog::write(uint8_t *buffer, size_t size) {
 //This splits writes up into 32 byte chunks
 boolean OpenLog::directWrite(String myString)
 {
-  while (myString.length() > 0)
+  //Skip the String copies and send the characters directly
+  return (write((const uint8_t *)myString.c_str(), myString.length()) == myString.length());
+}
+
+//Give OpenLog a buffer to batch writes into
+//OpenLog stalls the bus (clock stretching) while it commits a 512 byte sector to the SD card.
+//With a buffer we deliver data in sector sized bursts (16 back-to-back 32 byte chunks) lined up
+//with the sector boundaries so that each burst ends with a single commit.
+//Partial sectors wait in the buffer until they are filled or flush() is called.
+//Anything in the old buffer that still can't be sent is dropped.
+void OpenLog::setWriteBuffer(uint8_t *buffer, uint16_t bufferSize)
+{
+  flush(); //Send anything that is waiting in the old buffer
+
+  _writeBuffer = buffer;
+  _writeBufferSize = bufferSize;
+  _writeBufferUsed = 0;
+
+  if (_writeBufferSize < I2C_BUFFER_LENGTH) _writeBuffer = NULL; //Buffer is too small to be of use
+
+  if (_writeBuffer != NULL && _currentFile.length() > 0)
+  {
+    sendCommand(F("sync")); //So the size includes everything we've sent unbuffered
+    findSectorOffset();
+  }
+}
+
+//Find where the file OpenLog is appending to ends within its last sector so our bursts line up
+//with the sectors. The size is only needed when batching. OpenLog's default log can't be sized
+//by name so we assume it starts on a sector boundary.
+void OpenLog::findSectorOffset()
+{
+  _sectorOffset = 0;
+  if (_writeBuffer == NULL || _currentFile.length() == 0) return;
+
+  int32_t fileSize = size(_currentFile);
+  if (fileSize > 0) _sectorOffset = fileSize % QOL_SECTOR_SIZE; //-1 if the file doesn't exist yet
+}
+
+//Send any bytes that are waiting in the write buffer
+//This gets the data to OpenLog but OpenLog may still be holding it in its own buffer. Use sync() for that.
+void OpenLog::flush()
+{
+  if (_chunkUsed == 0 && _writeBufferUsed == 0) return; //Nothing to send
+
+  uint32_t startTime = micros();
+
+  endChunk();
+  sendWriteBuffer();
+
+  _stats.flushCount++;
+  _stats.flushMicros += micros() - startTime;
+}
+
+//Make sure everything we've written is on the SD card
+//OpenLog holds incoming data in RAM until it has a full sector. Sync causes it to commit
+//the partial sector. This is expensive so applications should sync periodically (once a second
+//for example) rather than after every write.
+//Returns true if OpenLog reports the sync succeeded
+boolean OpenLog::sync()
+{
+  uint32_t startTime = micros();
+
+  boolean result = sendCommand(F("sync")); //sendCommand will flush our buffer first
+  //Upon completion OpenLog will report if the sync was successful in its status byte
+
+  if (result == true)
+  {
+    uint8_t status = getStatus();
+    if ((status & 1<<STATUS_LAST_COMMAND_KNOWN) == 0 || (status & 1<<STATUS_LAST_COMMAND_SUCCESS) == 0)
+      result = false;
+  }
+
+  _stats.syncCount++;
+  _stats.syncMicros += micros() - startTime;
+
+  //Now that the data is on the card, check a sample of it
+  if (result == true && _verifyEvery > 0 && ++_syncsSinceCheck >= _verifyEvery)
+    result = checkSample();
+
+  return (result);
+}
+
+//Check what the card holds against what we sent
+//Every syncsPerCheck syncs a sample of sampleLength bytes, taken at a random spot in the
+//data written since the last check, is read back. Each check costs one read command.
+void OpenLog::setVerification(uint8_t syncsPerCheck, uint8_t sampleLength)
+{
+  if (sampleLength > QOL_VERIFY_SAMPLE_LENGTH) sampleLength = QOL_VERIFY_SAMPLE_LENGTH;
+  if (sampleLength == 0) sampleLength = 1;
+
+  _verifyEvery = syncsPerCheck;
+  _sampleLength = sampleLength;
+  if (_verifyEvery > 0) startFileChecksum();
+}
+
+//Read back everything written to the current file since append() and compare it to our checksum
+//This costs a read command per I2C_BUFFER_LENGTH bytes so use it sparingly, when closing a log for example
+boolean OpenLog::verifyFile()
+{
+  if (_verifyEvery == 0 || _currentFile.length() == 0) return (false); //Nothing to compare against
+
+  if (sendCommand(F("sync")) == false) //sendCommand will flush our buffer first
+    return (false);
+
+  uint32_t startTime = micros();
+
+  uint16_t crc = 0xFFFF;
+  uint8_t buffer[I2C_BUFFER_LENGTH];
+  for (uint32_t spot = 0 ; spot < _fileBytes ; spot += sizeof(buffer))
   {
-    //Pick the smaller of 32 or the length of the string to send
-    byte toSend = I2C_BUFFER_LENGTH;
-    if (myString.length() < toSend) toSend = myString.length();
+    uint16_t toRead = sizeof(buffer);
+    if (_fileBytes - spot < toRead) toRead = _fileBytes - spot;
+
+    read(buffer, toRead, _currentFile, _fileStart + spot);
+    for (uint16_t x = 0 ; x < toRead ; x++)
+      crc = crc16(crc, buffer[x]);
+  }
 
+  _stats.verifyCount++;
+  _stats.verifyMicros += micros() - startTime;
+
+  if (crc != _fileCrc)
+  {
+    _stats.verifyFailures++;
+    return (false);
+  }
+  return (true);
+}
+
+//Returns the CRC-16/CCITT of everything written to the current file since append()
+//Only kept while verification is on
+uint16_t OpenLog::getFileChecksum()
+{
+  return (_fileCrc);
+}
+
+//We're starting on a file. Find out where our data will start.
+void OpenLog::startFileChecksum()
+{
+  flush();
+
+  _fileStart = 0;
+  if (_currentFile.length() > 0)
+  {
+    int32_t fileSize = size(_currentFile);
+    if (fileSize > 0) _fileStart = fileSize; //-1 if the file doesn't exist yet
+  }
+
+  _fileBytes = 0;
+  _fileCrc = 0xFFFF;
+  _syncsSinceCheck = 0;
+  startSample();
+}
+
+//Add a byte headed for the current file to the checksum and the sample
+void OpenLog::trackByte(uint8_t character)
+{
+  if (_verifyEvery == 0) return;
+
+  _fileCrc = crc16(_fileCrc, character);
+  if (_sampleSkip > 0)
+    _sampleSkip--;
+  else if (_sampleUsed < _sampleLength)
+  {
+    if (_sampleUsed == 0) _sampleOffset = _fileBytes;
+    _sample[_sampleUsed++] = character;
+  }
+  _fileBytes++;
+}
+
+//Bytes were added to the current file by someone else (a general call broadcast for example)
+//Our write buffer must have been flushed first so the file holds them after everything we sent
+void OpenLog::noteWritten(const uint8_t *buffer, size_t size)
+{
+  for (size_t x = 0 ; x < size ; x++)
+    trackByte(buffer[x]);
+  _sectorOffset = (_sectorOffset + size) % QOL_SECTOR_SIZE;
+  _escapeRun = escapeRunAfter(buffer, size, _escapeRun);
+}
+
+//Returns false if sending these bytes next would make a run of escape characters long enough
+//to put OpenLog into command mode
+boolean OpenLog::rawWriteAllowed(const uint8_t *buffer, size_t size)
+{
+  return (escapeRunAfter(buffer, size, _escapeRun) < _escapeCharacterCount);
+}
+
+//Follow a run of escape characters through some data
+//Returns the length of the run at the end, or _escapeCharacterCount as soon as the run gets that long
+uint8_t OpenLog::escapeRunAfter(const uint8_t *data, size_t length, uint8_t run)
+{
+  for (size_t x = 0 ; x < length ; x++)
+  {
+    if (data[x] != _escapeCharacter)
+      run = 0;
+    else if (++run >= _escapeCharacterCount)
+      return (_escapeCharacterCount);
+  }
+  return (run);
+}
+
+//Sample somewhere in the next QOL_VERIFY_SPREAD bytes we write
+void OpenLog::startSample()
+{
+  _sampleSkip = random(QOL_VERIFY_SPREAD);
+  _sampleUsed = 0;
+}
+
+//Read back the sample and compare it with what we sent
+//Returns false if the card doesn't hold what we sent
+boolean OpenLog::checkSample()
+{
+  //Not enough written since the last check (or we're on OpenLog's default log which we can't read by name)
+  if (_sampleUsed < _sampleLength || _currentFile.length() == 0) return (true);
+
+  uint32_t startTime = micros();
+
+  uint8_t buffer[QOL_VERIFY_SAMPLE_LENGTH];
+  read(buffer, _sampleLength, _currentFile, _fileStart + _sampleOffset);
+  boolean result = (memcmp(buffer, _sample, _sampleLength) == 0);
+
+  _stats.verifyCount++;
+  _stats.verifyMicros += micros() - startTime;
+  if (result == false) _stats.verifyFailures++;
+
+  _syncsSinceCheck = 0;
+  startSample();
+  return (result);
+}
+
+//Return the running totals for flush, sync, and verification
+OpenLogStats OpenLog::getStats()
+{
+  return (_stats);
+}
+
+//Zero the flush, sync, and verification totals
+void OpenLog::resetStats()
+{
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+//Only record QOL_ macro lines at or above this level
+void OpenLog::setLevel(uint8_t level)
+{
+  for (uint8_t module = 0 ; module < QOL_MAX_MODULES ; module++)
+    _moduleLevels[module] = level;
+}
+
+//Only record QOL_ macro lines from this module at or above this level
+//Module numbers of QOL_MAX_MODULES and up are ignored
+void OpenLog::setLevel(uint8_t module, uint8_t level)
+{
+  if (module >= QOL_MAX_MODULES) return;
+  _moduleLevels[module] = level;
+}
+
+//Limit a module to a number of lines per second with bursts of up to burst lines
+//A burst of 0 would never let a line through so it is treated as 1
+void OpenLog::setRateLimit(uint8_t module, uint8_t linesPerSecond, uint8_t burst)
+{
+  if (module >= QOL_MAX_MODULES) return;
+  if (burst == 0) burst = 1;
+  LineLimit &limit = _limits[module];
+  limit.linesPerSecond = linesPerSecond;
+  limit.burst = burst;
+  limit.tokens = burst;
+  limit.lastRefill = millis();
+}
+
+//Drop a line if it is the same as the last line recorded from this module
+void OpenLog::setDuplicateSuppression(uint8_t module, boolean enable)
+{
+  if (module >= QOL_MAX_MODULES) return;
+  _limits[module].suppressDuplicates = enable;
+}
+
+//Decide if a line from a module should be recorded. This is called before the line is formatted.
+//Duplicates are checked first, then the rate limit. When a line is allowed, anything
+//that was dropped before it is reported on its own line first.
+boolean OpenLog::allowLine(uint8_t module, uint32_t messageHash)
+{
+  if (module >= QOL_MAX_MODULES) return (false);
+  LineLimit &limit = _limits[module];
+
+  if (limit.suppressDuplicates == true && messageHash != 0 && messageHash == limit.lastHash)
+  {
+    if (limit.repeats < 0xFFFF) limit.repeats++;
+    _stats.suppressedLines++;
+    return (false);
+  }
+
+  if (limit.linesPerSecond > 0)
+  {
+    //Add a token for every 1/linesPerSecond that has gone by
+    //After burst seconds the bucket is full no matter the rate, so long gaps can't overflow the math
+    uint32_t now = millis();
+    uint32_t elapsed = now - limit.lastRefill;
+    uint32_t earned = 0;
+    if (elapsed >= (uint32_t)limit.burst * 1000)
+    {
+      limit.tokens = limit.burst;
+      limit.lastRefill = now;
+    }
+    else
+      earned = elapsed * limit.linesPerSecond / 1000;
+    if (earned > 0)
+    {
+      limit.lastRefill += earned * 1000 / limit.linesPerSecond;
+      if (earned > (uint32_t)(limit.burst - limit.tokens)) limit.tokens = limit.burst;
+      else limit.tokens += earned;
+    }
+
+    if (limit.tokens == 0)
+    {
+      if (limit.dropped < 0xFFFF) limit.dropped++;
+      _stats.suppressedLines++;
+      return (false);
+    }
+    limit.tokens--;
+  }
+
+  if (limit.repeats > 0)
+  {
+    print(F("last message repeated "));
+    print(limit.repeats);
+    println(F(" times"));
+    limit.repeats = 0;
+  }
+  if (limit.dropped > 0)
+  {
+    print(limit.dropped);
+    println(F(" lines dropped by rate limit"));
+    limit.dropped = 0;
+  }
+
+  limit.lastHash = messageHash;
+  return (true);
+}
+
+//Tag the start of a line with its level: D, I, W, or E
+//Nothing is sent here. The tag waits until the first byte of the line so no I2C transaction is
+//open while the macro's arguments are evaluated (they may talk to other devices on the bus).
+void OpenLog::startLevelLine(uint8_t level)
+{
+  const char tags[] = "DIWE";
+  if (level > QOL_LEVEL_ERROR) level = QOL_LEVEL_ERROR;
+
+  _levelTag = tags[level];
+}
+
+//Start each line with a timestamp: seconds.milliseconds from millis()
+void OpenLog::setTimestamps(boolean enable)
+{
+  _timestamps = enable;
+  _prefixSeconds = 0xFFFFFFFF; //Render the seconds again on the next line
+}
+
+//Take line timestamps from an RTC (or GPS, etc) rather than millis()
+//The function fills in the current seconds and milliseconds. Pass NULL to go back to millis().
+void OpenLog::setTimestampSource(void (*timestampSource)(uint32_t &seconds, uint16_t &milliseconds))
+{
+  _timestampSource = timestampSource;
+  _prefixSeconds = 0xFFFFFFFF;
+}
+
+//Start each line with "#<sequence> ". The number goes up by one for every line.
+void OpenLog::setSequenceNumbers(boolean enable)
+{
+  _sequenceNumbers = enable;
+}
+
+void OpenLog::setSequenceNumber(uint32_t sequence)
+{
+  _sequenceNumber = sequence;
+}
+
+//Returns the number for the next record and moves on
+//Lines share the same counter so numbered lines and binary records can be mixed in one log.
+uint32_t OpenLog::nextSequenceNumber()
+{
+  return (_sequenceNumber++);
+}
+
+//End each line with "*XXXX", the CRC of everything on the line before the '*'
+//The CRC is worked out as the bytes go out so lines don't need to be held in RAM
+void OpenLog::setLineCrc(boolean enable)
+{
+  _lineCrc = enable;
+}
+
+//CRC-16/CCITT (polynomial 0x1021)
+//With QOL_CRC_BYTE_TABLE it takes one lookup per byte from a 512 byte table. Otherwise it takes two
+//lookups per byte from a 16 entry table that costs 32 bytes of flash.
+#if QOL_CRC_BYTE_TABLE
+static const uint16_t crcByteTable[256] PROGMEM = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+#else
+static const uint16_t crcNibbleTable[16] PROGMEM = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+#endif
+
+uint16_t OpenLog::crc16(uint16_t crc, uint8_t data)
+{
+#if QOL_CRC_BYTE_TABLE
+  crc = (crc << 8) ^ pgm_read_word(&crcByteTable[(crc >> 8) ^ data]);
+#else
+  crc = (crc << 4) ^ pgm_read_word(&crcNibbleTable[(crc >> 12) ^ (data >> 4)]);
+  crc = (crc << 4) ^ pgm_read_word(&crcNibbleTable[(crc >> 12) ^ (data & 0x0F)]);
+#endif
+  return (crc);
+}
+
+//Add a byte to the outgoing data, adding anything that goes at the start of a line first
+boolean OpenLog::stageByte(uint8_t character)
+{
+  if (_atLineStart == true)
+  {
+    _atLineStart = false;
+    _crc = 0xFFFF;
+    _lineCrcWritten = false;
+    if (_sequenceNumbers == true)
+    {
+      if (queueSequenceNumber() == false)
+        return (false);
+    }
+    if (_timestamps == true)
+    {
+      if (queueTimestamp() == false)
+        return (false);
+    }
+  }
+
+  if (_levelTag != '\0')
+  {
+    char tag = _levelTag;
+    _levelTag = '\0';
+    if (queueByte(tag) == false || queueByte(' ') == false)
+      return (false);
+  }
+
+  //The CRC goes in front of the line ending, \r\n or \n
+  if (_lineCrc == true && _lineCrcWritten == false && (character == '\r' || character == '\n'))
+  {
+    if (queueLineCrc() == false)
+      return (false);
+  }
+
+  if (character == '\n') _atLineStart = true;
+
+  return (queueByte(character));
+}
+
+//Pack bytes that aren't part of a text line: no line stages and no effect on the line CRC
+//so a text line that is part way through carries on as if they weren't there
+//Bytes that would put OpenLog into command mode are refused before any of them are packed
+boolean OpenLog::queueRaw(const uint8_t *data, size_t length)
+{
+  if (rawWriteAllowed(data, length) == false)
+    return (false);
+
+  uint16_t lineCrc = _crc;
+  boolean result = true;
+
+  for (size_t x = 0 ; x < length && result == true ; x++)
+    result = queueByte(data[x]);
+
+  _crc = lineCrc;
+  return (result);
+}
+
+//Pack "#<sequence> " for the start of a line
+boolean OpenLog::queueSequenceNumber()
+{
+  char digits[10];
+  uint8_t count = 0;
+  uint32_t value = nextSequenceNumber();
+  do
+  {
+    digits[count++] = '0' + (value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  if (queueByte('#') == false) return (false);
+  while (count > 0)
+  {
+    if (queueByte(digits[--count]) == false)
+      return (false);
+  }
+  return (queueByte(' '));
+}
+
+//Pack "*XXXX" for the end of a line
+boolean OpenLog::queueLineCrc()
+{
+  const char hex[] = "0123456789ABCDEF";
+  uint16_t crc = _crc; //queueByte keeps adding to _crc
+  _lineCrcWritten = true;
+
+  if (queueByte('*') == false) return (false);
+  for (int8_t shift = 12 ; shift >= 0 ; shift -= 4)
+  {
+    if (queueByte(hex[(crc >> shift) & 0x0F]) == false)
+      return (false);
+  }
+  return (true);
+}
+
+//Pack the timestamp for the start of a line
+//The seconds are only rendered when they change. Most lines just need the three millisecond digits.
+boolean OpenLog::queueTimestamp()
+{
+  uint32_t seconds;
+  uint16_t milliseconds;
+
+  if (_timestampSource != NULL)
+    _timestampSource(seconds, milliseconds);
+  else
+  {
+    uint32_t now = millis();
+    if (now - _prefixMillis >= 1000 || _prefixSeconds == 0xFFFFFFFF)
+    {
+      seconds = now / 1000; //Once a second at most
+      _prefixMillis = seconds * 1000;
+    }
+    else
+      seconds = _prefixSeconds;
+    milliseconds = now - _prefixMillis;
+  }
+
+  if (seconds != _prefixSeconds)
+  {
+    //Render the digits backwards then flip them around
+    _prefixLength = 0;
+    uint32_t value = seconds;
+    do
+    {
+      _prefixText[_prefixLength++] = '0' + (value % 10);
+      value /= 10;
+    } while (value > 0);
+
+    for (uint8_t x = 0 ; x < _prefixLength / 2 ; x++)
+    {
+      char temp = _prefixText[x];
+      _prefixText[x] = _prefixText[_prefixLength - 1 - x];
+      _prefixText[_prefixLength - 1 - x] = temp;
+    }
+    _prefixText[_prefixLength++] = '.';
+
+    _prefixSeconds = seconds;
+  }
+
+  for (uint8_t x = 0 ; x < _prefixLength ; x++)
+  {
+    if (queueByte(_prefixText[x]) == false)
+      return (false);
+  }
+
+  uint8_t hundreds = milliseconds / 100;
+  uint8_t remainder = milliseconds - hundreds * 100;
+  uint8_t tens = remainder / 10;
+
+  if (queueByte('0' + hundreds) == false) return (false);
+  if (queueByte('0' + tens) == false) return (false);
+  if (queueByte('0' + remainder - tens * 10) == false) return (false);
+  return (queueByte(' '));
+}
+
+//Add a byte to the outgoing data
+//Without a write buffer the byte goes straight into the open I2C transaction and
+//the transaction is sent when it reaches I2C_BUFFER_LENGTH
+boolean OpenLog::queueByte(uint8_t character)
+{
+  if (_writeBuffer != NULL && _writeBufferUsed == _writeBufferSize)
+  {
+    //An earlier burst couldn't be sent. Try again before we take any more.
+    if (sendWriteBuffer() == false)
+      return (false);
+  }
+
+  if (_lineCrc == true) _crc = crc16(_crc, character);
+
+  trackByte(character);
+  _escapeRun = (character == _escapeCharacter) ? _escapeRun + 1 : 0;
+
+  if (_writeBuffer != NULL)
+  {
+    _writeBuffer[_writeBufferUsed++] = character;
+
+    //Send a burst when we hit the end of the sector or the buffer is full
+    uint16_t burstSize = QOL_SECTOR_SIZE - _sectorOffset;
+    if (burstSize > _writeBufferSize) burstSize = _writeBufferSize;
+
+    if (_writeBufferUsed >= burstSize)
+      return (sendWriteBuffer());
+    return (true);
+  }
+
+  if (_chunkUsed == 0)
     _i2cPort->beginTransmission(_deviceAddress);
-    _i2cPort->print(myString.substring(0, toSend));
-    if (_i2cPort->endTransmission() != 0)
-		return(0); //Error: Sensor did not ack
 
-    //Remove what we just sent from the big string
-    myString = myString.substring(toSend, myString.length());
+  _i2cPort->write(character);
+  _chunkUsed++;
+
+  if (_chunkUsed == I2C_BUFFER_LENGTH)
+    return (endChunk());
+  return (true);
+}
+
+//Send the I2C transaction that is currently being filled
+boolean OpenLog::endChunk()
+{
+  if (_chunkUsed == 0) return (true); //Nothing to send
+
+  _chunkUsed = 0;
+  if (_i2cPort->endTransmission() != 0)
+    return (false); //Error: Sensor did not ack
+
+  return (true);
+}
+
+//Send one I2C transaction of data
+boolean OpenLog::sendChunk(const uint8_t *data, uint8_t length)
+{
+  _i2cPort->beginTransmission(_deviceAddress);
+  _i2cPort->write(data, length);
+  if (_i2cPort->endTransmission() != 0)
+    return (false); //Error: Sensor did not ack
+
+  return (true);
+}
+
+//Send one I2C transaction of data that is stored in flash
+boolean OpenLog::sendFlashChunk(PGM_P data, uint8_t length)
+{
+  _i2cPort->beginTransmission(_deviceAddress);
+  for (uint8_t x = 0 ; x < length ; x++)
+    _i2cPort->write(pgm_read_byte(data + x));
+  if (_i2cPort->endTransmission() != 0)
+    return (false); //Error: Sensor did not ack
+
+  return (true);
+}
+
+//Send the contents of the write buffer as back-to-back I2C_BUFFER_LENGTH chunks
+boolean OpenLog::sendWriteBuffer()
+{
+  uint16_t startPoint = 0;
+  boolean result = true;
+
+  while (startPoint < _writeBufferUsed)
+  {
+    //Pick the smaller of 32 or the remaining number of characters to send
+    uint16_t toSend = _writeBufferUsed - startPoint;
+    if (toSend > I2C_BUFFER_LENGTH) toSend = I2C_BUFFER_LENGTH;
+
+    if (sendChunk(&_writeBuffer[startPoint], toSend) == false)
+    {
+      result = false; //Error: Sensor did not ack
+      break;
+    }
+
+    startPoint += toSend;
   }
-  
-  return(1); //Done!
-}
\ No newline at end of file
+
+  _sectorOffset = (_sectorOffset + startPoint) % QOL_SECTOR_SIZE;
+
+  //Keep anything that didn't go out. It's sent ahead of the next burst.
+  _writeBufferUsed -= startPoint;
+  if (_writeBufferUsed > 0)
+    memmove(_writeBuffer, &_writeBuffer[startPoint], _writeBufferUsed);
+
+  return (result);
+}
@@ -45,6 +45,138 @@
 #define STATUS_FILE_OPEN 3
 #define STATUS_IN_ROOT_DIRECTORY 4
 
+//Optional firmware features. Firmware from QOL_CAPABILITY_VERSION on answers the "cap"
+//command with a byte made of these bits. begin() asks and the library uses what's there.
+#define QOL_CAPABILITY_VERSION 2 //First major version that knows "cap"
+#define QOL_FEATURE_BINARY_COMMANDS 0 //Length prefixed commands with NUL separated options
+#define QOL_FEATURE_PACKED_LS 1 //ls responses carry as many names as fit
+#define QOL_FEATURE_GENERAL_CALL 2 //Records data sent to the I2C general call address (see OpenLogArray)
+#define QOL_FEATURE_LS_SKIP 3 //ls -s<count> leaves out the first <count> names (combined with -p as -ps<count>)
+#define QOL_BINARY_COMMAND 0x01 //Follows the escape characters to mark a binary command
+
+//OpenLog commits data to the SD card in 512 byte sectors
+#define QOL_SECTOR_SIZE 512
+
+//crc16() looks up a whole byte at a time from a 512 byte table, or a nibble at a time from a 32 byte
+//table. AVR boards default to the small table to save flash. Define QOL_CRC_BYTE_TABLE as 0 or 1 to choose.
+#ifndef QOL_CRC_BYTE_TABLE
+#if defined(__AVR__)
+#define QOL_CRC_BYTE_TABLE 0
+#else
+#define QOL_CRC_BYTE_TABLE 1
+#endif
+#endif
+
+//Read back verification compares up to this many bytes at a random spot in each sector or so written
+#define QOL_VERIFY_SAMPLE_LENGTH 16
+#define QOL_VERIFY_SPREAD 512
+
+//Running totals of the time spent in flush(), sync(), and read back verification
+//Divide the micros by the count to get the average cost of each call
+struct OpenLogStats
+{
+  uint32_t flushCount; //Number of flushes that had data to send
+  uint32_t flushMicros;
+  uint32_t syncCount;
+  uint32_t syncMicros;
+  uint32_t suppressedLines; //Lines dropped by rate limiting or duplicate suppression
+  uint32_t verifyCount; //Number of read back checks
+  uint32_t verifyMicros;
+  uint32_t verifyFailures; //Checks where the card didn't hold what we sent
+};
+
+//One piece of a record for writev(). For example a header struct, a payload, and a checksum.
+struct OpenLogFragment
+{
+  const uint8_t *data;
+  size_t length;
+};
+
+//Room for an 8.3 file name, or a directory name and its trailing /
+#define QOL_MAX_NAME_LENGTH 12
+typedef char OpenLogName[QOL_MAX_NAME_LENGTH + 1];
+
+//Where a paged directory listing is up to. See listPage().
+struct OpenLogListCursor
+{
+  OpenLogName options; //Wildcard given to ls
+  OpenLogName lastName; //Last name handed out
+  OpenLogName nextName; //Name read ahead to start the next page
+  uint16_t index; //Number of names handed out so far
+  uint16_t position; //Names ahead of nextName in the listing
+  uint32_t commandStamp; //OpenLog's command count when the last page ended
+  boolean searching; //True once this cursor has sent its own ls
+  boolean done;
+};
+
+//Levels for the QOL_DEBUG/QOL_INFO/QOL_WARN/QOL_ERROR macros
+#define QOL_LEVEL_DEBUG 0
+#define QOL_LEVEL_INFO 1
+#define QOL_LEVEL_WARN 2
+#define QOL_LEVEL_ERROR 3
+#define QOL_LEVEL_NONE 4
+
+#define QOL_MAX_MODULES 8 //Modules 0 to 7 can each have their own runtime level. Lines from other module numbers are not recorded.
+
+//Levels below this are removed at compile time. Their arguments are never evaluated.
+//#define QOL_COMPILE_LEVEL QOL_LEVEL_WARN before including this library for a production build.
+#ifndef QOL_COMPILE_LEVEL
+#define QOL_COMPILE_LEVEL QOL_LEVEL_DEBUG
+#endif
+
+//QOL_INFO(myLog, MODULE_GPS, "Fix acquired");
+//Lines are recorded as "I Fix acquired". Anything println() accepts can be logged.
+//Rate limits are checked before the line is formatted. When the module has duplicate suppression
+//turned on the line is formatted once into a hash (with the line number of the call) so the same call
+//with a new value still gets recorded. The arguments are evaluated twice in that case.
+#define QOL_LOG(log, level, module, ...) \
+  do { if ((log).levelEnabled((module), (level))) { \
+    uint32_t qolHash = 0; \
+    if ((log).suppressingDuplicates(module)) { OpenLogLineHash qolHasher(__LINE__); qolHasher.print(__VA_ARGS__); qolHash = qolHasher.getHash(); } \
+    if ((log).allowLine((module), qolHash)) { (log).startLevelLine(level); (log).println(__VA_ARGS__); } \
+  } } while (0)
+
+//Hashes whatever is printed to it so QOL_LOG can spot repeated lines without holding them in RAM
+//32 bit FNV-1a, started from the line number of the call
+class OpenLogLineHash : public Print {
+  public:
+    OpenLogLineHash(uint16_t line) { _hash = (2166136261UL ^ line) * 16777619UL; }
+    virtual size_t write(uint8_t character)
+    {
+      _hash = (_hash ^ character) * 16777619UL;
+      return (1);
+    }
+    using Print::write;
+    uint32_t getHash() { return (_hash != 0 ? _hash : 1); } //0 means "don't check for duplicates"
+
+  private:
+    uint32_t _hash;
+};
+
+#if QOL_COMPILE_LEVEL <= QOL_LEVEL_DEBUG
+#define QOL_DEBUG(log, module, ...) QOL_LOG(log, QOL_LEVEL_DEBUG, module, __VA_ARGS__)
+#else
+#define QOL_DEBUG(log, module, ...) do { } while (0)
+#endif
+
+#if QOL_COMPILE_LEVEL <= QOL_LEVEL_INFO
+#define QOL_INFO(log, module, ...) QOL_LOG(log, QOL_LEVEL_INFO, module, __VA_ARGS__)
+#else
+#define QOL_INFO(log, module, ...) do { } while (0)
+#endif
+
+#if QOL_COMPILE_LEVEL <= QOL_LEVEL_WARN
+#define QOL_WARN(log, module, ...) QOL_LOG(log, QOL_LEVEL_WARN, module, __VA_ARGS__)
+#else
+#define QOL_WARN(log, module, ...) do { } while (0)
+#endif
+
+#if QOL_COMPILE_LEVEL <= QOL_LEVEL_ERROR
+#define QOL_ERROR(log, module, ...) QOL_LOG(log, QOL_LEVEL_ERROR, module, __VA_ARGS__)
+#else
+#define QOL_ERROR(log, module, ...) do { } while (0)
+#endif
+
 //Platform specific configurations
 
 //Define the size of the I2C buffer based on the platform the user has
@@ -74,38 +206,171 @@
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
 
+//A constant line stored in flash. The number of I2C_BUFFER_LENGTH transactions it takes
+//is worked out at compile time so writing it needs no length calculation or copying.
+//Create these with QOL_CONSTANT_LINE and send them with myLog.write(name)
+template <size_t N>
+struct OpenLogConstantLine
+{
+  PGM_P text;
+
+  enum
+  {
+    length = N - 1, //Leave off the terminator
+    fullChunks = length / I2C_BUFFER_LENGTH,
+    lastChunk = length % I2C_BUFFER_LENGTH
+  };
+};
+
+//QOL_CONSTANT_LINE(header, "Time,Temperature,Humidity\r\n");
+#define QOL_CONSTANT_LINE(name, literal) \
+  static const char name##_text[] PROGMEM = literal; \
+  static const OpenLogConstantLine<sizeof(literal)> name = {name##_text}
+
 class OpenLog : public Print {
 
   public:
     //These functions override the built-in print functions so that when the user does an 
     //myLogger.println("send this"); it gets chopped up and sent over I2C instead of Serial
-    virtual size_t write(uint8_t *buffer, size_t size);
+    virtual size_t write(const uint8_t *buffer, size_t size);
     virtual size_t write(uint8_t character);
+    using Print::write;
 	boolean directWrite(String myString); //Faster direct writing. Avoids built-in print function overhead.
+    size_t writev(const OpenLogFragment *fragments, uint8_t fragmentCount); //Write several pieces as one record without copying them together. Sent as is, like writeRaw().
+
+    //Write bytes exactly as given, without the line timestamps, sequence numbers, or CRCs below
+    //Use this for binary data and for files that have their own format
+    //Three escape characters (0x1A) in a row would put OpenLog into command mode part way through the file,
+    //so writeRaw() and writev() refuse (send nothing and return 0) any write that would make that run,
+    //counting escape characters at the end of what was sent before. Binary formats must escape 0x1A
+    //themselves (OpenLogTimeSeries follows each one with a 0x00).
+    size_t writeRaw(const uint8_t *buffer, size_t size);
+    boolean rawWriteAllowed(const uint8_t *buffer, size_t size); //False if these bytes would put OpenLog into command mode
+
+    //Strings stored in flash with F("...") are sent in I2C_BUFFER_LENGTH chunks rather than one byte at a time
+    size_t write(const __FlashStringHelper *flashString);
+    size_t print(const __FlashStringHelper *flashString);
+    size_t println(const __FlashStringHelper *flashString);
+    using Print::print;
+    using Print::println;
+
+    //Send a line made with QOL_CONSTANT_LINE as pre-sized transactions
+    template <size_t N>
+    size_t write(const OpenLogConstantLine<N> &line)
+    {
+      //Batched, part way through a transaction, or adding to lines: go through the normal path
+      if (_writeBuffer != NULL || _chunkUsed > 0 || _levelTag != '\0' || _timestamps == true || _sequenceNumbers == true || _lineCrc == true || _verifyEvery > 0)
+        return (write(reinterpret_cast<const __FlashStringHelper *>(line.text)));
+
+      PGM_P spot = line.text;
+      for (uint16_t chunk = 0 ; chunk < OpenLogConstantLine<N>::fullChunks ; chunk++)
+      {
+        if (sendFlashChunk(spot, I2C_BUFFER_LENGTH) == false)
+          return (0); //Error: Sensor did not ack
+        spot += I2C_BUFFER_LENGTH;
+      }
+      if (OpenLogConstantLine<N>::lastChunk > 0)
+      {
+        if (sendFlashChunk(spot, OpenLogConstantLine<N>::lastChunk) == false)
+          return (0);
+      }
+
+      if (OpenLogConstantLine<N>::length > 0)
+        _atLineStart = (pgm_read_byte(line.text + OpenLogConstantLine<N>::length - 1) == '\n');
+
+      return (OpenLogConstantLine<N>::length);
+    }
+
+    //Runtime log levels for the QOL_ macros
+    void setLevel(uint8_t level); //Set the level for every module
+    void setLevel(uint8_t module, uint8_t level); //Set the level for one module
+    boolean levelEnabled(uint8_t module, uint8_t level) //Two comparisons
+    {
+      return (module < QOL_MAX_MODULES && level >= _moduleLevels[module]);
+    }
+    void startLevelLine(uint8_t level); //Used by the QOL_ macros to tag the line with its level
+
+    //Per module rate limiting and duplicate suppression for the QOL_ macros
+    void setRateLimit(uint8_t module, uint8_t linesPerSecond, uint8_t burst); //0 lines per second = no limit. A burst of 0 is treated as 1.
+    void setDuplicateSuppression(uint8_t module, boolean enable); //Collapse repeats into "last message repeated N times"
+    boolean allowLine(uint8_t module, uint32_t messageHash); //Returns false if the line should be dropped. A hash of 0 is never a duplicate.
+    boolean suppressingDuplicates(uint8_t module) { return (module < QOL_MAX_MODULES && _limits[module].suppressDuplicates); }
+
+    //Line stages: timestamps, sequence numbers, and CRCs are only added to text written with print() and write()
+    //writeRaw(), writev(), and the helper classes (OpenLogKeyValue, OpenLogRing, etc) send their bytes as they are
+
+    //Start each line with a "seconds.milliseconds " timestamp
+    void setTimestamps(boolean enable);
+    void setTimestampSource(void (*timestampSource)(uint32_t &seconds, uint16_t &milliseconds)); //Use an RTC instead of millis()
+
+    //Start each line with "#<sequence> " so lost, repeated, or reordered lines can be found later (see extras/tools/qol_gaps.cpp)
+    void setSequenceNumbers(boolean enable);
+    void setSequenceNumber(uint32_t sequence); //Number to give the next record
+    uint32_t nextSequenceNumber(); //Take a number for a record, such as a binary struct, that the library doesn't number for you
+
+    //End each line with "*XXXX", the CRC-16/CCITT of everything on the line before the '*' (see extras/tools/qol_crc.cpp)
+    //Only text from print() and write() gets a CRC. Binary data from writeRaw() and writev() is left alone.
+    void setLineCrc(boolean enable);
+    static uint16_t crc16(uint16_t crc, uint8_t data); //Add a byte to a CRC-16/CCITT. Start with 0xFFFF. Use it for your own binary frames.
+
+    //Batch writes into sector sized bursts. The buffer is supplied by the user, ideally QOL_SECTOR_SIZE bytes.
+    //Pass NULL to go back to sending each write immediately.
+    //If OpenLog stops taking data the bytes stay in the buffer and go out ahead of the next burst. Writes and
+    //commands fail until then. A write that fails may already have left some of its bytes in the buffer.
+    void setWriteBuffer(uint8_t *buffer, uint16_t bufferSize);
+    virtual void flush(); //Send any partially filled sector that is waiting in the write buffer
+    boolean sync(); //Flush, then have OpenLog commit everything it has received to the SD card
+
+    OpenLogStats getStats(); //Returns the time spent in flush(), sync(), and verification
+    void resetStats();
+
+    //Read back verification. A checksum of everything written since append() is kept and a small
+    //sample at a random spot is read back after every syncsPerCheck syncs. sync() returns false if the sample doesn't match.
+    void setVerification(uint8_t syncsPerCheck, uint8_t sampleLength = QOL_VERIFY_SAMPLE_LENGTH); //0 syncs turns verification off
+    boolean verifyFile(); //Read back everything written since append() and compare checksums. Slow.
+    uint16_t getFileChecksum(); //CRC-16 of everything written since append()
 
     //By default use the default I2C addres, and use Wire port
     boolean begin(uint8_t deviceAddress = QOL_DEFAULT_ADDRESS, TwoWire &wirePort = Wire);
     boolean begin(int deviceAddress); 
 
     String getVersion(); //Returns a string that is the current firmware version
+    uint8_t getVersionMajor(); //Version read by begin()
+    uint8_t getVersionMinor();
+    uint8_t getFeatures(); //QOL_FEATURE_ bits the firmware supports
+    boolean hasFeature(uint8_t feature);
+
+    //Account for bytes that reached the current file without going through this OpenLog, such as an
+    //OpenLogArray broadcast, so verification and sector batching stay in step. Call flush() before they are sent.
+    void noteWritten(const uint8_t *buffer, size_t size);
     uint8_t getStatus(); //Returns various status bits
 
     boolean setI2CAddress(uint8_t addr); //Set the I2C address we read and write to
     boolean append(String fileName); //Open and append to a file
+    const String &getCurrentFile(); //Returns the name of the file we last appended to
     boolean create(String fileName); //Create a file but don't open it for writing
     boolean makeDirectory(String directoryName); //Create the given directory
     boolean changeDirectory(String directoryName); //Change to the given directory
     int32_t size(String fileName); //Given a file name, read the size of the file
+    uint16_t size(const char *const fileNames[], uint16_t count, int32_t fileSizes[]); //Sizes of a list of files in one go. Returns the number found.
 
     void read(uint8_t* userBuffer, uint16_t bufferSize, String fileName); //Read the contents of a file into the provided buffer
-    void read(uint8_t* userBuffer, uint16_t bufferSize, String fileName, uint16_t startingSpot);
+    void read(uint8_t* userBuffer, uint16_t bufferSize, String fileName, uint32_t startingSpot);
 
     boolean searchDirectory(String options); //Search the current directory for a given wildcard
     String getNextDirectoryItem(); //Return the next file or directory from the search
 
-    uint32_t removeFile(String thingToDelete); //Remove file
-    uint32_t removeDirectory(String thingToDelete); //Remove a directory including the contents of the directory
-    uint32_t remove(String thingToDelete, boolean removeEverthing); //Remove file or directory including the contents of the directory
+    //Paged directory listing. Other commands can be sent between pages and the listing picks up where it left off,
+    //found again by name. Files can be removed between pages (including the ones just listed) without missing any.
+    //Picking up after another command costs one read on firmware with QOL_FEATURE_LS_SKIP. Older firmware has to
+    //read the listing from the top to find the name again, so interrupted pages cost a read for every name ahead of them.
+    void startListing(OpenLogListCursor &cursor, const char *options = "*");
+    void startListingAfter(OpenLogListCursor &cursor, const char *options, const char *name, uint16_t position); //Pick up a listing after a name found at position, such as a directory we went down into
+    uint8_t listPage(OpenLogListCursor &cursor, OpenLogName names[], uint8_t maxNames); //Returns the number of names. 0 at the end.
+
+    int32_t removeFile(String thingToDelete); //Remove file
+    int32_t removeDirectory(String thingToDelete); //Remove a directory including the contents of the directory
+    int32_t remove(String thingToDelete, boolean removeEverthing); //Remove file or directory including the contents of the directory
 
     //These are the core functions that send a command to OpenLog
     boolean sendCommand(String command);
@@ -113,12 +378,93 @@ class OpenLog : public Print {
     boolean sendCommand(String command, String option1, String option2);
 
   private:
+    void readVersion(); //Ask for the version and cache it
+    boolean stageByte(uint8_t character); //Add anything that goes at the start of a line, then queue the byte
+    boolean queueTimestamp(); //Pack the timestamp for the start of a line
+    boolean queueSequenceNumber(); //Pack "#<sequence> " for the start of a line
+    boolean queueLineCrc(); //Pack "*XXXX" for the end of a line
+    boolean queueByte(uint8_t character); //Pack a byte into the current I2C transaction or the write buffer
+    boolean queueRaw(const uint8_t *data, size_t length); //Pack bytes that aren't part of a text line
+    uint8_t escapeRunAfter(const uint8_t *data, size_t length, uint8_t run); //Escape characters in a row at the end, or _escapeCharacterCount if the run gets that long
+    boolean endChunk(); //Close out a partially filled I2C transaction
+    size_t queueFlash(const __FlashStringHelper *flashString); //Pack a string from flash. Returns the length or 0 on error.
+    boolean sendChunk(const uint8_t *data, uint8_t length); //Send one I2C transaction of data
+    boolean sendFlashChunk(PGM_P data, uint8_t length); //Send one I2C transaction of data from flash
+    boolean sendWriteBuffer(); //Send the write buffer as back-to-back I2C_BUFFER_LENGTH chunks. Unsent bytes are kept.
+    void findSectorOffset(); //Size the current file to line our bursts up with its sectors
+    void startFileChecksum(); //Find where our writes start in the current file and clear the checksum
+    void trackByte(uint8_t character); //Add a byte we've sent to the file checksum and sample
+    void startSample(); //Pick a random spot ahead of us to sample
+    boolean checkSample(); //Read back the sample and compare
+    boolean startSearch(String options, uint16_t skip); //Send ls, leaving out the first skip names if the firmware can
+    boolean findName(const char *options, const char *wanted, uint16_t &position); //Start a search and read up to the given name
 
     //Variables
     TwoWire *_i2cPort; //The generic connection to user's chosen I2C hardware
     uint8_t _deviceAddress; //Keeps track of I2C address. setI2CAddress changes this.
     uint8_t _escapeCharacter = 26; //The character that needs to be sent to QOL to get it into command mode
     uint8_t _escapeCharacterCount = 3; //Number of escape characters to get QOL into command mode
+    uint8_t _escapeRun = 0; //Escape characters in a row at the end of the data sent since the last command
+
+    uint8_t _versionMajor = 0; //0 until we've read the version
+    uint8_t _versionMinor = 0;
+    uint8_t _features = 0; //QOL_FEATURE_ bits. None until begin() finds out otherwise.
 
     boolean _searchStarted = false; //Goes true when user does a search. Goes false when we reach end of directory.
+    boolean _packedListing = false; //The search responses carry as many names as fit
+    uint8_t _listing[I2C_BUFFER_LENGTH]; //The last packed response
+    uint8_t _listingUsed = 0;
+    uint8_t _listingSpot = 0; //Next byte of _listing to look at
+    uint32_t _commandCount = 0; //Goes up with every command so a paged listing can tell if its search was interrupted
+    String _currentFile = ""; //The file OpenLog is currently appending to. Set by append().
+
+    uint8_t _chunkUsed = 0; //Number of bytes in the I2C transaction that is currently open
+
+    uint8_t *_writeBuffer = NULL; //User supplied buffer used for sector batching
+    uint16_t _writeBufferSize = 0;
+    uint16_t _writeBufferUsed = 0;
+    uint16_t _sectorOffset = 0; //Number of bytes we've pushed into the current 512 byte sector of the log
+
+    OpenLogStats _stats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    uint8_t _verifyEvery = 0; //Number of syncs between read back checks. 0 = off
+    uint8_t _syncsSinceCheck = 0;
+    uint32_t _fileStart = 0; //Size of the current file when we started writing to it
+    uint32_t _fileBytes = 0; //Bytes written to the current file since _fileStart
+    uint16_t _fileCrc = 0xFFFF;
+    uint8_t _sample[QOL_VERIFY_SAMPLE_LENGTH]; //Copy of some bytes we wrote
+    uint8_t _sampleLength = 0; //Bytes to sample
+    uint8_t _sampleUsed = 0; //Bytes sampled so far
+    uint16_t _sampleSkip = 0; //Bytes to let go by before sampling
+    uint32_t _sampleOffset = 0; //Where _sample starts, counted from _fileStart
+
+    uint8_t _moduleLevels[QOL_MAX_MODULES] = {0}; //Everything that's compiled in is recorded by default
+
+    //Token bucket and repeat counter for each module
+    struct LineLimit
+    {
+      uint8_t linesPerSecond; //0 = no rate limit
+      uint8_t burst; //Most tokens we'll save up
+      uint8_t tokens;
+      boolean suppressDuplicates;
+      uint32_t lastRefill; //millis() when tokens were last added
+      uint32_t lastHash; //Hash of the last line we recorded
+      uint16_t repeats; //Duplicates dropped since the last recorded line
+      uint16_t dropped; //Lines dropped by the rate limit since the last recorded line
+    };
+    LineLimit _limits[QOL_MAX_MODULES] = {};
+
+    boolean _atLineStart = true; //The next byte written starts a new line
+    char _levelTag = '\0'; //Level tag from startLevelLine() waiting to go in front of the next byte
+    boolean _timestamps = false;
+    boolean _sequenceNumbers = false;
+    uint32_t _sequenceNumber = 0; //Number given to the next record
+    boolean _lineCrc = false;
+    boolean _lineCrcWritten = false; //The CRC for this line has gone out
+    uint16_t _crc = 0xFFFF; //CRC of the line so far
+    void (*_timestampSource)(uint32_t &seconds, uint16_t &milliseconds) = NULL;
+    uint32_t _prefixSeconds = 0xFFFFFFFF; //The seconds that are rendered in _prefixText
+    uint32_t _prefixMillis = 0; //millis() at the start of _prefixSeconds
+    char _prefixText[11]; //Seconds and the decimal point
+    uint8_t _prefixLength = 0;
 };